@@ -0,0 +1,430 @@
+/**
+ * @file LoaderBench.cpp
+ * @brief Micro-benchmarks for the asset loader stages on a fixed corpus.
+ * Usage: LoaderBench [--corpus <dir>] [--json <file or ->] [--min-time <seconds>] [--filter <text>]
+ * Every .obj, .mtl and image file in the corpus directory (assets/objects by default, so run from
+ * the project root like AssetPacker) is timed through the loader stage that handles it:
+ *     read         mapping the file and touching every page
+ *     find_mtllib  parseOBJMaterial, the OBJ header scan done by ObjectLoader::MeasureAssets
+ *                  (its throughput counts the bytes up to the mtllib line only)
+ *     parse_obj    parseOBJ on the in-memory text, single-threaded
+ *     scan_mtl     parseMTLDiffuseMap, the MTL scan done by ObjectLoader::Load
+ *     decode_image stbi_load_from_memory to RGBA8: only the image decoder inside Texture::Decode,
+ *                  which also builds the mip chain, may BC1-compress it, and is skipped entirely
+ *                  when the derived-asset cache holds the result
+ * The first OBJ of the corpus is also replicated 10x and 100x into synthetic meshes (each copy
+ * shifted so no vertices weld across copies) to show how parseOBJ scales with input size. The
+ * 100x mesh is also parsed with 2, 4 and 8 threads (parse_obj_2t and so on) to show how the
+ * chunked parser scales with threads.
+ * Each case reports its median and minimum time, throughput in MB/s of input, and the number and
+ * size of the heap allocations made per run. The JSON output carries the same numbers so results
+ * can be kept and compared across releases.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "../src/Loader/ObjectLoader.h"
+#include "../src/Utils/AssetArchive.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Heap traffic of the code under test. operator new is replaced below, and stb_image is built
+// privately in this file with its allocator routed through the same counters.
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<uint64_t> allocationBytes{0};
+
+// Keeps the page reads of the read stage from being optimized away
+static volatile unsigned char pageSink;
+
+static void *countedMalloc(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size);
+}
+
+static void *countedRealloc(void *p, size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::realloc(p, size);
+}
+
+void *operator new(size_t size) {
+    void *p = countedMalloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// Same decoder as Texture.cpp, but with static linkage so its allocations can be counted
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size) countedMalloc(size)
+#define STBI_REALLOC(p, size) countedRealloc(p, size)
+#define STBI_FREE(p) std::free(p)
+
+#include "../third_party/stb_image.h"
+
+/**
+ * @struct Result
+ * @brief Measurements of one benchmark case.
+ */
+struct Result {
+    std::string name;     // stage/input
+    std::string stage;
+    std::string input;
+    uint64_t bytes = 0;   // Input bytes processed per run
+    int iterations = 0;
+    double medianMs = 0;
+    double minMs = 0;
+    double mbPerSecond = 0; // From the median
+    uint64_t allocations = 0; // Per run
+    uint64_t allocatedBytes = 0;
+};
+
+/**
+ * @struct Options
+ * @brief Command line settings.
+ */
+struct Options {
+    std::string corpus = "assets/objects";
+    std::string jsonPath;   // Empty = no JSON, "-" = standard output
+    double minTime = 0.5;   // Seconds spent on each case, after one warm-up run
+    int minIterations = 3;
+    std::string filter;     // Only cases whose name contains this
+};
+
+/**
+ * @brief Times a case until both the minimum time and the minimum iteration count are reached.
+ * The run function returns false if the stage failed, which aborts the case.
+ */
+template<typename Run>
+static bool measure(const Options &options, const std::string &stage, const std::string &input, uint64_t bytes,
+                    Run run, std::vector<Result> &results) {
+    Result result;
+    result.stage = stage;
+    result.input = input;
+    result.name = stage + "/" + input;
+    result.bytes = bytes;
+    if (!options.filter.empty() && result.name.find(options.filter) == std::string::npos) return true;
+
+    if (!run()) {
+        std::cerr << "Failed: " << result.name << std::endl;
+        return false;
+    }
+    std::vector<double> times;
+    const uint64_t countBefore = allocationCount.load(), bytesBefore = allocationBytes.load();
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        const auto t0 = std::chrono::steady_clock::now();
+        run();
+        const auto t1 = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    } while ((int) times.size() < options.minIterations ||
+             std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < options.minTime);
+    result.iterations = (int) times.size();
+    result.allocations = (allocationCount.load() - countBefore) / times.size();
+    result.allocatedBytes = (allocationBytes.load() - bytesBefore) / times.size();
+
+    std::sort(times.begin(), times.end());
+    result.minMs = times.front();
+    result.medianMs = times[times.size() / 2];
+    result.mbPerSecond = result.medianMs > 0 ? (double) bytes / (1024.0 * 1024.0) / (result.medianMs / 1000.0) : 0;
+    std::printf("%-44s %10.3f ms %10.3f ms %9.1f MB/s %8llu allocs %12llu bytes\n", result.name.c_str(),
+                result.medianMs, result.minMs, result.mbPerSecond, (unsigned long long) result.allocations,
+                (unsigned long long) result.allocatedBytes);
+    results.push_back(result);
+    return true;
+}
+
+/**
+ * @brief Builds an OBJ with copies of a source OBJ, each offset along X and with its face indices rebased.
+ * Records other than v, vt, vn and f (comments, mtllib, groups) are kept from the first copy only.
+ */
+static std::string replicateOBJ(const char *data, size_t size, int copies) {
+    // Count the records of one copy, which is how far the indices of the next copy move
+    size_t positions = 0, texcoords = 0, normals = 0;
+    float extent = 0;
+    for (const char *p = data, *end = data + size; p < end;) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        const char *lineEnd = eol ? eol : end;
+        if (lineEnd - p >= 2 && p[0] == 'v') {
+            if (p[1] == ' ') {
+                ++positions;
+                float x = 0;
+                std::from_chars(p + 2, lineEnd, x);
+                extent = std::max(extent, std::abs(x));
+            } else if (p[1] == 't') ++texcoords;
+            else if (p[1] == 'n') ++normals;
+        }
+        p = eol ? eol + 1 : end;
+    }
+
+    std::string out;
+    out.reserve(size * copies + size / 2 * copies);
+    char buffer[64];
+    for (int copy = 0; copy < copies; ++copy) {
+        const float dx = 2.0f * (extent + 1.0f) * (float) copy;
+        const size_t base[3] = {positions * copy, texcoords * copy, normals * copy};
+        for (const char *p = data, *end = data + size; p < end;) {
+            const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+            const char *lineEnd = eol ? eol : end;
+            const char *next = eol ? eol + 1 : end;
+            const bool vertex = lineEnd - p >= 2 && p[0] == 'v';
+            const bool face = lineEnd - p >= 2 && p[0] == 'f' && p[1] == ' ';
+            if (!vertex && !face && copy > 0) {
+                p = next;
+                continue;
+            }
+            if (vertex && p[1] == ' ') {
+                // Shift x; the rest of the line is copied as is
+                const char *q = p + 2;
+                while (q < lineEnd && *q == ' ') ++q;
+                float x = 0;
+                auto [rest, ec] = std::from_chars(q, lineEnd, x);
+                out.append(buffer, std::snprintf(buffer, sizeof(buffer), "v %.6f", x + dx));
+                out.append(ec == std::errc() ? rest : q, lineEnd);
+            } else if (face) {
+                // Rebase the indices of each v, v/t, v//n or v/t/n corner
+                out += 'f';
+                const char *q = p + 1;
+                while (true) {
+                    while (q < lineEnd && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+                    if (q >= lineEnd) break;
+                    out += ' ';
+                    int component = 0;
+                    while (q < lineEnd && *q != ' ' && *q != '\t' && *q != '\r') {
+                        if (*q == '/') {
+                            out += '/';
+                            ++component;
+                            ++q;
+                            continue;
+                        }
+                        long index = 0;
+                        auto [after, ec] = std::from_chars(q, lineEnd, index);
+                        if (ec != std::errc()) {
+                            out += *q++;
+                            continue;
+                        }
+                        if (index > 0) index += (long) base[std::min(component, 2)];
+                        out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), index).ptr);
+                        q = after;
+                    }
+                }
+            } else {
+                out.append(p, lineEnd);
+            }
+            out += '\n';
+            p = next;
+        }
+    }
+    return out;
+}
+
+static std::string jsonEscape(const std::string &text) {
+    std::string out;
+    for (char c: text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+/**
+ * @brief Writes the results, and the totals per stage over the shipped corpus, as JSON.
+ */
+static bool writeJSON(const Options &options, const std::vector<Result> &results, std::ostream &out) {
+    std::map<std::string, Result> totals;
+    for (const auto &r: results) {
+        if (r.input.rfind("synthetic-", 0) == 0) continue;
+        Result &t = totals[r.stage];
+        t.bytes += r.bytes;
+        t.medianMs += r.medianMs;
+        t.minMs += r.minMs;
+        t.allocations += r.allocations;
+        t.allocatedBytes += r.allocatedBytes;
+    }
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    char number[64];
+    auto fixed = [&](double value) {
+        std::snprintf(number, sizeof(number), "%.4f", value);
+        return std::string(number);
+    };
+
+    out << "{\n";
+    out << "  \"benchmark\": \"LoaderBench\",\n";
+    out << "  \"version\": 1,\n";
+    out << "  \"timestamp\": " << timestamp << ",\n";
+    out << "  \"corpus\": \"" << jsonEscape(options.corpus) << "\",\n";
+#ifdef NDEBUG
+    out << "  \"optimized\": true,\n";
+#else
+    out << "  \"optimized\": false,\n";
+#endif
+    out << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+    out << "  \"cases\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"stage\": \"" << r.stage << "\", \"input\": \""
+            << jsonEscape(r.input) << "\", \"bytes\": " << r.bytes << ", \"iterations\": " << r.iterations
+            << ", \"median_ms\": " << fixed(r.medianMs) << ", \"min_ms\": " << fixed(r.minMs)
+            << ", \"mb_per_s\": " << fixed(r.mbPerSecond) << ", \"allocations\": " << r.allocations
+            << ", \"allocated_bytes\": " << r.allocatedBytes << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"stages\": {\n";
+    size_t i = 0;
+    for (const auto &[stage, t]: totals) {
+        const double mbPerSecond = t.medianMs > 0 ? (double) t.bytes / (1024.0 * 1024.0) / (t.medianMs / 1000.0) : 0;
+        out << "    \"" << stage << "\": {\"bytes\": " << t.bytes << ", \"median_ms\": " << fixed(t.medianMs)
+            << ", \"min_ms\": " << fixed(t.minMs) << ", \"mb_per_s\": " << fixed(mbPerSecond)
+            << ", \"allocations\": " << t.allocations << ", \"allocated_bytes\": " << t.allocatedBytes << "}"
+            << (++i < totals.size() ? "," : "") << "\n";
+    }
+    out << "  }\n";
+    out << "}\n";
+    return (bool) out;
+}
+
+static bool parseArguments(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--corpus" && hasValue) options.corpus = argv[++i];
+        else if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+        else if (arg == "--min-time" && hasValue) options.minTime = std::atof(argv[++i]);
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--corpus <dir>] [--json <file or ->] [--min-time <seconds>] [--filter <text>]" << std::endl;
+        return 2;
+    }
+
+    // A fixed, ordered corpus keeps runs comparable
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (fs::directory_iterator it(options.corpus, ec), end; it != end; it.increment(ec))
+        if (it->is_regular_file()) files.push_back(it->path());
+    if (ec || files.empty()) {
+        std::cerr << "No corpus files in " << options.corpus << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    std::printf("%-44s %13s %13s %14s %15s %18s\n", "case", "median", "min", "throughput", "allocations",
+                "allocated");
+    std::vector<Result> results;
+    std::vector<ObjectLoader::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::string name;
+    std::string firstOBJ;
+    bool ok = true;
+    for (const auto &path: files) {
+        const std::string extension = path.extension().string();
+        const std::string input = path.filename().string();
+        AssetFile file;
+        if (!file.Open(path.generic_string())) {
+            std::cerr << "Cannot open " << path.string() << std::endl;
+            return 1;
+        }
+        const char *data = file.Data();
+        const size_t size = file.Size();
+
+        ok &= measure(options, "read", input, size, [&]() {
+            AssetFile mapped;
+            if (!mapped.Open(path.generic_string())) return false;
+            // Touch one byte per page so the mapping is actually read
+            unsigned char sum = 0;
+            for (size_t i = 0; i < mapped.Size(); i += 4096) sum += (unsigned char) mapped.Data()[i];
+            pageSink = sum;
+            return true;
+        }, results);
+
+        if (extension == ".obj") {
+            if (firstOBJ.empty()) firstOBJ.assign(data, size);
+            // The header scan stops after the mtllib line, so only that prefix counts as processed
+            const size_t mtllib = std::string_view(data, size).find("mtllib");
+            const size_t eol = std::string_view(data, size).find('\n', mtllib);
+            const size_t scanned = mtllib == std::string_view::npos || eol == std::string_view::npos ? size : eol + 1;
+            ok &= measure(options, "find_mtllib", input, scanned, [&]() {
+                parseOBJMaterial(data, size, name);
+                return true;
+            }, results);
+            ok &= measure(options, "parse_obj", input, size, [&]() {
+                return parseOBJ(data, size, input, vertices, indices, name, 1);
+            }, results);
+        } else if (extension == ".mtl") {
+            ok &= measure(options, "scan_mtl", input, size, [&]() {
+                parseMTLDiffuseMap(data, size, name);
+                return true;
+            }, results);
+        } else if (extension == ".jpg" || extension == ".jpeg" || extension == ".png") {
+            ok &= measure(options, "decode_image", input, size, [&]() {
+                int width, height, channels;
+                stbi_uc *pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(data), (int) size, &width,
+                                                        &height, &channels, STBI_rgb_alpha);
+                if (!pixels) return false;
+                stbi_image_free(pixels);
+                return true;
+            }, results);
+        }
+    }
+
+    // Larger meshes than the corpus ships, to catch costs that grow faster than the input
+    if (!firstOBJ.empty()) {
+        for (int scale: {10, 100}) {
+            const std::string synthetic = replicateOBJ(firstOBJ.data(), firstOBJ.size(), scale);
+            const std::string input = "synthetic-" + std::to_string(scale) + "x.obj";
+            ok &= measure(options, "parse_obj", input, synthetic.size(), [&]() {
+                return parseOBJ(synthetic.data(), synthetic.size(), input, vertices, indices, name, 1);
+            }, results);
+            if (scale != 100) continue;
+            for (unsigned int threads: {2u, 4u, 8u}) {
+                ok &= measure(options, "parse_obj_" + std::to_string(threads) + "t", input, synthetic.size(), [&]() {
+                    return parseOBJ(synthetic.data(), synthetic.size(), input, vertices, indices, name, threads);
+                }, results);
+            }
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        if (options.jsonPath == "-") {
+            ok &= writeJSON(options, results, std::cout);
+        } else {
+            std::ofstream out(options.jsonPath, std::ios::trunc);
+            if (!out.is_open() || !writeJSON(options, results, out)) {
+                std::cerr << "Cannot write " << options.jsonPath << std::endl;
+                return 1;
+            }
+            std::cout << "Wrote " << results.size() << " results to " << options.jsonPath << std::endl;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file ShotBench.cpp
+ * @brief Headless check and benchmark of ShotSolver on the opening break.
+ * Usage: ShotBench [--json <file or ->] [--min-time <seconds>]
+ * Racks the 15 object balls as a triangle with its apex on the foot spot, puts the cue ball on the
+ * head spot and solves the break at a few cue speeds. Every solved shot is checked before it is
+ * timed:
+ *     settled   Solve() returned before its event limit, and every ball that moved has its last
+ *               event a rest
+ *     apart     no two balls are closer than two radii
+ *     on table  every ball centre is inside the cushions, one radius from them
+ * Each case reports its median and minimum time, the number of events and the simulated time until
+ * the last ball stopped. The JSON output carries the same numbers. Exits with 1 if any check fails.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "../src/Scene/BallSystem.h"
+#include "../src/Scene/Constants.h"
+#include "../src/Scene/ShotSolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Slack on the distance checks, for the float positions the solver stores its results in
+static constexpr float TOLERANCE = 1e-5f;
+
+/**
+ * @struct Result
+ * @brief Measurements of one benchmark case.
+ */
+struct Result {
+    std::string name;
+    int iterations = 0;
+    double medianMs = 0;
+    double minMs = 0;
+    size_t events = 0;
+    double shotSeconds = 0; // Simulated time until the last ball stopped
+};
+
+/**
+ * @struct Options
+ * @brief Command line settings.
+ */
+struct Options {
+    std::string jsonPath;   // Empty = no JSON, "-" = standard output
+    double minTime = 0.5;   // Seconds spent on each case, after one checked run
+    int minIterations = 3;
+};
+
+/**
+ * @brief Sets up the break: a tight rack on the foot spot and the cue ball on the head spot.
+ * The cue ball is aimed a hair off the rack's axis, as no real break is exactly symmetric.
+ * @param speed Speed of the cue ball in m/s.
+ */
+static void rackBreak(BallSystem &balls, float speed) {
+    const float radius = Constants::BALL_RADIUS;
+    const float y = Constants::OUTER_HEIGHT / 2.0f + radius;
+    const float spacing = 2.0f * radius + 0.001f;
+    const float footSpot = Constants::PLAY_LENGTH / 4.0f;
+    for (int row = 0; row < 5; ++row)
+        for (int col = 0; col <= row; ++col)
+            balls.Add({footSpot + spacing * row * 0.8660254f, y, spacing * (col - row / 2.0f)});
+    const int cue = balls.Add({-footSpot, y, 0.0f});
+    balls.SetVelocity(cue, glm::vec3(1.0f, 0.0f, 0.0005f) * speed);
+}
+
+/**
+ * @brief Checks that a solved shot ended settled, with the balls apart and on the table.
+ * Prints what is wrong and returns false if any check fails.
+ */
+static bool checkShot(const std::string &name, const BallSystem &start, const ShotSolver &solver, bool solved) {
+    bool ok = true;
+    if (!solved) {
+        std::cerr << name << ": hit the event limit before the balls settled" << std::endl;
+        ok = false;
+    }
+
+    // The last event of every ball that moved must be its rest
+    const int count = start.GetCount();
+    std::vector<int> last(count, -1);
+    for (const auto &event: solver.GetEvents()) {
+        last[event.a] = event.type;
+        if (event.b >= 0) last[event.b] = event.type;
+    }
+    for (int i = 0; i < count; ++i) {
+        const bool moved = last[i] >= 0 || glm::length(start.GetVelocity(i)) > 0.0f;
+        if (moved && last[i] != ShotSolver::Event::REST) {
+            std::cerr << name << ": ball " << i << " is still moving" << std::endl;
+            ok = false;
+        }
+    }
+
+    const float radius = Constants::BALL_RADIUS;
+    const float maxX = Constants::PLAY_LENGTH / 2.0f - radius + TOLERANCE;
+    const float maxZ = Constants::PLAY_WIDTH / 2.0f - radius + TOLERANCE;
+    for (int i = 0; i < count; ++i) {
+        const glm::vec3 p = solver.GetPosition(i);
+        if (std::fabs(p.x) > maxX || std::fabs(p.z) > maxZ) {
+            std::cerr << name << ": ball " << i << " ended outside the cushions at (" << p.x << ", " << p.z << ")"
+                      << std::endl;
+            ok = false;
+        }
+        for (int j = i + 1; j < count; ++j) {
+            const glm::vec3 q = solver.GetPosition(j);
+            const float distance = glm::length(glm::vec2(p.x - q.x, p.z - q.z));
+            if (distance < 2.0f * radius - TOLERANCE) {
+                std::cerr << name << ": balls " << i << " and " << j << " overlap by " << 2.0f * radius - distance
+                          << " m" << std::endl;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Checks one break, then times loading and solving it until both minimums are reached.
+ */
+static bool measure(const Options &options, float speed, std::vector<Result> &results) {
+    Result result;
+    char name[32];
+    std::snprintf(name, sizeof(name), "break/%gmps", speed);
+    result.name = name;
+
+    BallSystem start;
+    rackBreak(start, speed);
+    ShotSolver solver;
+    solver.Load(start);
+    if (!checkShot(result.name, start, solver, solver.Solve())) return false;
+    result.events = solver.GetEvents().size();
+    result.shotSeconds = solver.GetTime();
+
+    std::vector<double> times;
+    const auto begin = std::chrono::steady_clock::now();
+    do {
+        const auto t0 = std::chrono::steady_clock::now();
+        ShotSolver run;
+        run.Load(start);
+        run.Solve();
+        const auto t1 = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    } while ((int) times.size() < options.minIterations ||
+             std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < options.minTime);
+    result.iterations = (int) times.size();
+
+    std::sort(times.begin(), times.end());
+    result.minMs = times.front();
+    result.medianMs = times[times.size() / 2];
+    std::printf("%-20s %10.3f ms %10.3f ms %8zu events %8.2f s\n", result.name.c_str(), result.medianMs,
+                result.minMs, result.events, result.shotSeconds);
+    results.push_back(result);
+    return true;
+}
+
+/**
+ * @brief Writes the results as JSON.
+ */
+static bool writeJSON(const std::vector<Result> &results, std::ostream &out) {
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    char buffer[64];
+    auto fixed = [&](double value) {
+        std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+        return std::string(buffer);
+    };
+    out << "{\n";
+    out << "  \"timestamp\": " << timestamp << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+            << ", \"median_ms\": " << fixed(r.medianMs) << ", \"min_ms\": " << fixed(r.minMs)
+            << ", \"events\": " << r.events << ", \"shot_seconds\": " << fixed(r.shotSeconds) << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return (bool) out;
+}
+
+static bool parseArguments(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+        else if (arg == "--min-time" && hasValue) options.minTime = std::atof(argv[++i]);
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--json <file or ->] [--min-time <seconds>]" << std::endl;
+        return 2;
+    }
+
+    std::printf("%-20s %13s %13s %15s %10s\n", "case", "median", "min", "events", "shot");
+    std::vector<Result> results;
+    bool ok = true;
+    for (float speed: {2.0f, 8.0f, 14.0f})
+        ok &= measure(options, speed, results);
+
+    if (!options.jsonPath.empty()) {
+        if (options.jsonPath == "-") {
+            ok &= writeJSON(results, std::cout);
+        } else {
+            std::ofstream out(options.jsonPath, std::ios::trunc);
+            if (!out.is_open() || !writeJSON(results, out)) {
+                std::cerr << "Cannot write " << options.jsonPath << std::endl;
+                return 1;
+            }
+            std::cout << "Wrote " << results.size() << " results to " << options.jsonPath << std::endl;
+        }
+    }
+    return ok ? 0 : 1;
+}
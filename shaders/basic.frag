@@ -25,6 +25,11 @@ uniform sampler2D texture1;
 uniform vec3 objectColor;
 uniform bool useTexture;
 
+// Ball textures, one layer per ball; textureLayer is -1 while the layer is still uploading
+uniform sampler2DArray ballTextures;
+uniform bool useTextureArray;
+uniform int textureLayer;
+
 // Ambient light
 uniform bool enableAmbient;
 uniform vec3 ambientColor;
@@ -91,6 +96,10 @@ void main()
         result += spotLightColor * diff * objectColor * attenuation * intensity;
     }
 
-    vec4 baseColor = useTexture ? texture(texture1, TexCoord) : vec4(objectColor, 1.0);
+    vec4 baseColor = vec4(objectColor, 1.0);
+    if (useTextureArray && textureLayer >= 0)
+        baseColor = texture(ballTextures, vec3(TexCoord, float(textureLayer)));
+    else if (useTexture)
+        baseColor = texture(texture1, TexCoord);
     FragColor = vec4(result, 1.0) * baseColor;
 }
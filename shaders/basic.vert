@@ -3,6 +3,8 @@
     * This shader is used for rendering basic objects with lighting and texture mapping.
     * It takes vertex positions, normals, and texture coordinates as input.
     * The shader applies transformations and computes lighting based on the provided uniforms.
+    * Meshes drawn with quantized = true use the packed vertex format (see Mesh::PackedVertex):
+    * normalized 16-bit positions and texcoords, and octahedral-encoded normals in aNormal.xy.
     * @file basic.vert
     * @version 1.0
     * @date 2025-05-27
@@ -21,10 +23,34 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// Dequantization of packed vertices: value = offset + normalized * scale
+uniform bool quantized;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+uniform vec2 texCoordOffset;
+uniform vec2 texCoordScale;
+
+// Inverse of the octahedral normal encoding in Mesh.cpp
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    TexCoord = aTexCoord;
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    vec3 pos = aPos;
+    vec3 normal = aNormal;
+    vec2 texCoord = aTexCoord;
+    if (quantized) {
+        pos = positionOffset + aPos * positionScale;
+        normal = octDecode(aNormal.xy);
+        texCoord = texCoordOffset + aTexCoord * texCoordScale;
+    }
+    gl_Position = projection * view * model * vec4(pos, 1.0);
+    TexCoord = texCoord;
+    FragPos = vec3(model * vec4(pos, 1.0));
+    Normal = mat3(transpose(inverse(model))) * normal;
 }
 
@@ -151,6 +151,10 @@ App::App() {
     camera = new Camera(WINDOW_WIDTH / WINDOW_HEIGHT);
     minimap = new Minimap(renderer, Table::OUTER_WIDTH, Table::OUTER_HEIGHT);
     scene = new Scene();
+    scene->SetLoaderThreadCount(LOADER_THREADS);
+    scene->SetContinuousCollisions(PHYSICS_CCD);
+    ObjectLoader::SetLodThresholds(LOD_SCREEN_RADII);
+    DerivedCache::Instance().Configure(DERIVED_CACHE_PATH, DERIVED_CACHE_LIMIT);
 }
 
 App::~App() {
@@ -160,6 +164,10 @@ App::~App() {
     delete scene;
 }
 
+void App::SetBallTessellation(int segments) {
+    scene->SetBallTessellation(segments);
+}
+
 /**
  * @brief Runs the main application loop.
  * Initializes GLFW, creates a window, sets up callbacks,
@@ -202,6 +210,27 @@ void App::Run() {
         Logger::Error("Failed to initialize GLEW");
         return;
     }
+    Texture::SetCompression(TEXTURE_COMPRESSION && GLEW_EXT_texture_compression_s3tc);
+
+    // Mount the asset archive before anything is loaded; without it the loose files are used
+    if (!AssetArchive::Instance().Mount(ASSET_ARCHIVE))
+        Logger::Info(std::string("No asset archive at ") + ASSET_ARCHIVE + ", reading loose asset files");
+
+    // Queue reads for every loose file of the load at once; loaders pick them up as they complete.
+    // Only names known without reading anything are queued here; the MTL and texture files named
+    // inside the ball files are queued by the reader thread as those arrive.
+    if (ASSET_PREFETCH && !AssetArchive::Instance().IsMounted()) {
+        std::vector<std::string> paths = {LOADING_IMAGE_PATH};
+        std::vector<std::string> ballFiles = scene->ListBallModelFiles();
+        paths.insert(paths.end(), ballFiles.begin(), ballFiles.end());
+        paths.push_back(SHADERS_PATH "basic.vert");
+        paths.push_back(SHADERS_PATH "basic.frag");
+        AssetPrefetcher::Instance().Start(paths, [](const std::string &path, std::span<const std::byte> data,
+                                                    std::vector<std::string> &outPaths) {
+            ObjectLoader::ListReferencedAssets(path, reinterpret_cast<const char *>(data.data()), data.size(),
+                                               outPaths);
+        });
+    }
 
     // Load loading image
     Texture loadingTexture;
@@ -211,48 +240,81 @@ void App::Run() {
     }
 
     // --- Threaded asset loading ---
-    std::atomic<float> progress(0.0f);
+    LoadProgress progress;
     std::atomic<bool> done(false);
+    std::atomic<bool> finished(false);
     float spinnerAngle = 0.0f;
 
-    // Create a shared context for the background thread
-    GLFWwindow *bgWindow = glfwCreateWindow(1, 1, "", nullptr, window); // Share with mainWindow
-    glfwHideWindow(bgWindow);
-    std::thread bgThread([&]() {
-        glfwMakeContextCurrent(bgWindow);
-        // Now safe to make OpenGL calls in this thread
-        scene->LoadBallsThreaded(&progress, &done);
-        done.store(true); // Signal that loading is done
-        glfwMakeContextCurrent(nullptr); // Optional: release context
+    // The loader only does CPU work (parsing, decoding), so it needs no OpenGL context of its own.
+    // A jthread hands the loader a stop token, so closing the window can cancel the load.
+    std::jthread bgThread([&](std::stop_token stop) {
+        scene->LoadBallsThreaded(&progress, &done, stop);
+        finished.store(true); // Signal that the loader has returned, loaded or not
     });
 
     // --- Main thread loading screen ---
-    glfwMakeContextCurrent(window);
-    while (!done.load()) {
+    while (!finished.load()) {
+        if (glfwWindowShouldClose(window)) {
+            bgThread.request_stop();
+            break;
+        }
         spinnerAngle += 1.0f; // Increment spinner angle
         if (spinnerAngle >= 360.0f) spinnerAngle = 0.0f; // Reset angle
-        DrawLoadingScreen(window, &loadingTexture, spinnerAngle, progress.load());
+        DrawLoadingScreen(window, &loadingTexture, spinnerAngle, progress.GetFraction());
     }
-    bgThread.join(); // Wait for the background thread to finish
-    glfwDestroyWindow(bgWindow); // Clean up the background window
-    glfwMakeContextCurrent(window); // Switch back to the main window context
+    bgThread.join(); // Returns promptly after a stop request
     // Clear texture after loading
     loadingTexture.Release();
+    if (!done.load()) {
+        Logger::Info("Loading cancelled, exiting");
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return;
+    }
     // --- End of threaded loading ---
 
-    // Now, in the main thread, create and install balls (OpenGL calls)
-    scene->InstallBalls(); // This should do all OpenGL-dependent work
+    // Now, in the main thread, upload meshes and queue the decoded textures for streaming
+    scene->InstallBalls();
     scene->SetRenderer(renderer);
 
     // Create and use the main shader
-    Shader mainShader("shaders/basic.vert", "shaders/basic.frag");
+    Shader mainShader(SHADERS_PATH "basic.vert", SHADERS_PATH "basic.frag");
+
+    // Everything prefetched has been read; drop the buffers so later opens see the files on disk
+    AssetPrefetcher::Instance().Release();
+
+    // Watch the loose asset and shader files; changed ones are prepared off-thread and swapped in at
+    // the top of a frame. Files inside the archive cannot change, so there is nothing to watch then.
+    HotReloader hotReloader;
+    if (HOT_RELOAD && AssetArchive::Instance().IsMounted()) {
+        Logger::Info(std::string("Hot reload is off while assets are read from ") + ASSET_ARCHIVE);
+    } else if (HOT_RELOAD && hotReloader.Start({ASSETS_PATH, SHADERS_PATH})) {
+        for (const std::string &path: {mainShader.GetVertexPath(), mainShader.GetFragmentPath()}) {
+            hotReloader.Register(path, [&mainShader](const std::string &) -> HotReloader::Apply {
+                std::string vertexSource = Shader::ReadSource(mainShader.GetVertexPath());
+                std::string fragmentSource = Shader::ReadSource(mainShader.GetFragmentPath());
+                return [&mainShader, vertexSource, fragmentSource]() {
+                    mainShader.Reload(vertexSource, fragmentSource);
+                };
+            });
+        }
+        scene->EnableHotReload(hotReloader);
+    }
+
     // Main loop
+    FixedTimestep physicsClock(PHYSICS_RATE, PHYSICS_MAX_STEPS);
     double lastTime = glfwGetTime();
     while (!glfwWindowShouldClose(window)) {
         double currentTime = glfwGetTime();
         auto deltaTime = static_cast<float>(currentTime - lastTime);
         lastTime = currentTime;
 
+        // Swap in the resources whose files changed, before anything of this frame is drawn
+        hotReloader.Update();
+
+        // Stream queued textures through PBOs; balls render untextured until theirs arrive
+        TextureUploader::Instance().Pump();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // --- Main Scene ---
@@ -269,8 +331,10 @@ void App::Run() {
         glViewport(0, 0, width, height);
         // Set the camera matrices as uniforms
         mainShader.setInt("texture1", 0);
+        mainShader.setInt("ballTextures", 1); // The array needs its own unit, samplers of different types can't share one
         mainShader.setMat4("projection", proj);
         mainShader.setMat4("view", view);
+        ObjectLoader::SetViewContext(view, proj, (float) height);
 
         // --- Lighting toggles and parameters ---
         static bool enableAmbient = true;
@@ -335,7 +399,9 @@ void App::Run() {
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Set blending function
 
         // ---- Update physics ----
-        scene->Update(deltaTime);
+        // Fixed steps, so a frame hitch cannot become one huge step and results do not depend on the frame rate
+        for (int steps = physicsClock.Advance(deltaTime); steps > 0; --steps)
+            scene->Update(physicsClock.GetStep());
         minimap->SetBallPositions(&scene->GetBallPositions());
 
         // Place this at the top of your main loop, outside any if/else:
@@ -352,7 +418,7 @@ void App::Run() {
         }
 
         // ---- Draw the scene ----
-        scene->Render();
+        scene->Render(physicsClock.GetAlpha());
 
         // ---- Draw the minimap ----
         minimap->Render(width, height);
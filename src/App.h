@@ -28,6 +28,12 @@
 #include "Loader/ObjectLoader.h"
 #include "Scene/Scene.h"
 #include "Renderer/Texture.h"
+#include "Renderer/TextureUploader.h"
+#include "Utils/AssetArchive.h"
+#include "Utils/AssetPrefetcher.h"
+#include "Utils/DerivedCache.h"
+#include "Utils/FixedTimestep.h"
+#include "Utils/HotReloader.h"
 #include "Utils/Logger.h"
 
 // Define the Paths
@@ -36,6 +42,31 @@
 #define IMAGE_PATH ASSETS_PATH "images/"
 #define LOADING_IMAGE "loading16-9.png"
 #define LOADING_IMAGE_PATH IMAGE_PATH LOADING_IMAGE
+#define SHADERS_PATH "shaders/"
+// Define the packed asset archive; when it is missing, assets are read from the loose files above
+#define ASSET_ARCHIVE "assets.pak"
+// Define whether the loose files of the load are read ahead in one batch (1 = on; io_uring on Linux, plain reads otherwise)
+#define ASSET_PREFETCH 1
+// Define the number of asset loader threads (0 = one per hardware thread)
+#define LOADER_THREADS 0
+// Define whether opaque textures are compressed to BC1 (1 = on, needs S3TC)
+#define TEXTURE_COMPRESSION 1
+// Define the directory holding compiled meshes, texture chains and program binaries, and its size cap in bytes;
+// the least recently used entries are deleted beyond the cap, and --clear-cache empties it at startup
+#define DERIVED_CACHE_PATH "cache/"
+#define DERIVED_CACHE_LIMIT (256ull * 1024 * 1024)
+// Define whether changed shaders, ball textures and ball meshes reload while the app runs
+// (1 = on; needs inotify, so Linux only, and loose asset files rather than the archive)
+#define HOT_RELOAD 1
+// Define the physics rate in steps per second, and the most steps one frame may run; after a longer
+// hitch the simulation drops the rest of the time instead of trying to catch up
+#define PHYSICS_RATE 240.0
+#define PHYSICS_MAX_STEPS 8
+// Define whether ball contacts are found by continuous collision detection (1 = on); with it, fast
+// shots stay correct at much lower physics rates, e.g. 60
+#define PHYSICS_CCD 1
+// Define the projected model radii in pixels below which the next coarser LOD is drawn
+#define LOD_SCREEN_RADII {48.0f, 20.0f, 8.0f}
 // Define the Window Size
 #define WINDOW_WIDTH 1600.0f
 #define WINDOW_HEIGHT 900.0f
@@ -60,6 +91,14 @@ public:
 
     ~App();
 
+    /**
+     * @brief Sets whether the balls use generated spheres instead of the OBJ geometry.
+     * Call before Run(). Generated spheres skip the OBJ import, the mesh cache and mesh hot reload.
+     * @param segments Segments and rings of the finest sphere; 0 (the default) loads the OBJ geometry,
+     * 64 matches its tessellation.
+     */
+    void SetBallTessellation(int segments);
+
     void Run();
 
 private:
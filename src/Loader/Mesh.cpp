@@ -0,0 +1,209 @@
+/**
+ * @file Mesh.cpp
+ * @brief Implementation of the Mesh class.
+ * Handles vertex quantization, uploading indexed geometry to OpenGL buffers, and drawing it.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "Mesh.h"
+#include "MeshBlob.h"
+#include "../Renderer/Shader.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @fn toSnorm16
+ * @brief Converts a value in [-1, 1] to a 16-bit signed normalized integer.
+ */
+static int16_t toSnorm16(float v) {
+    v = glm::clamp(v, -1.0f, 1.0f);
+    return (int16_t) std::lround(v * 32767.0f);
+}
+
+/**
+ * @fn toUnorm16
+ * @brief Converts a value in [0, 1] to a 16-bit unsigned normalized integer.
+ */
+static uint16_t toUnorm16(float v) {
+    v = glm::clamp(v, 0.0f, 1.0f);
+    return (uint16_t) std::lround(v * 65535.0f);
+}
+
+/**
+ * @fn octEncode
+ * @brief Projects a unit normal onto the octahedron and unfolds it into the [-1, 1] square.
+ * The inverse is octDecode in shaders/basic.vert.
+ */
+static glm::vec2 octEncode(glm::vec3 n) {
+    float l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    if (l1 <= 0.0f) return glm::vec2(0.0f, 0.0f);
+    n = n / l1;
+    glm::vec2 e(n.x, n.y);
+    if (n.z < 0.0f) {
+        e.x = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        e.y = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return e;
+}
+
+/**
+ * @fn Quantize
+ * @brief Quantizes full precision vertices into the packed format.
+ * Positions and texcoords are normalized against their bounding boxes, so the full 16-bit
+ * range covers the actual extent of the mesh.
+ */
+Mesh::Quantization Mesh::Quantize(const std::vector<Vertex> &vertices, std::vector<PackedVertex> &outPacked) {
+    Quantization q;
+    outPacked.clear();
+    if (vertices.empty()) return q;
+    glm::vec3 pMin = vertices[0].position, pMax = vertices[0].position;
+    glm::vec2 tMin = vertices[0].texCoord, tMax = vertices[0].texCoord;
+    for (const auto &v: vertices) {
+        pMin = glm::min(pMin, v.position);
+        pMax = glm::max(pMax, v.position);
+        tMin = glm::vec2(std::min(tMin.x, v.texCoord.x), std::min(tMin.y, v.texCoord.y));
+        tMax = glm::vec2(std::max(tMax.x, v.texCoord.x), std::max(tMax.y, v.texCoord.y));
+    }
+    q.positionOffset = (pMin + pMax) * 0.5f;
+    q.positionScale = (pMax - pMin) * 0.5f;
+    for (int i = 0; i < 3; ++i)
+        if (q.positionScale[i] <= 0.0f) q.positionScale[i] = 1.0f; // Flat axis, any scale works
+    q.texCoordOffset = tMin;
+    q.texCoordScale = tMax - tMin;
+    for (int i = 0; i < 2; ++i)
+        if (q.texCoordScale[i] <= 0.0f) q.texCoordScale[i] = 1.0f;
+
+    outPacked.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex &v = vertices[i];
+        PackedVertex &p = outPacked[i];
+        glm::vec3 pos = (v.position - q.positionOffset) / q.positionScale;
+        p.position[0] = toSnorm16(pos.x);
+        p.position[1] = toSnorm16(pos.y);
+        p.position[2] = toSnorm16(pos.z);
+        p.padding = 0;
+        glm::vec2 oct = octEncode(v.normal);
+        p.normal[0] = toSnorm16(oct.x);
+        p.normal[1] = toSnorm16(oct.y);
+        p.texCoord[0] = toUnorm16((v.texCoord.x - q.texCoordOffset.x) / q.texCoordScale.x);
+        p.texCoord[1] = toUnorm16((v.texCoord.y - q.texCoordOffset.y) / q.texCoordScale.y);
+    }
+    return q;
+}
+
+/**
+ * @brief Constructor for Mesh.
+ * Quantizes the vertices and keeps the packed arrays until the mesh is installed.
+ */
+Mesh::Mesh(std::string name, const std::vector<Vertex> &vertices, std::vector<unsigned int> indices,
+           std::vector<Lod> lods)
+        : name(std::move(name)), indices(std::move(indices)), lods(std::move(lods)) {
+    quantization = Quantize(vertices, packed);
+    for (const auto &v: vertices)
+        boundingRadius = std::max(boundingRadius, glm::length(v.position - quantization.positionOffset));
+    vertexCount = packed.size();
+    indexCount = this->indices.size();
+    vertexData = packed.data();
+    indexData = this->indices.data();
+    if (this->lods.empty()) this->lods.push_back({0, static_cast<uint32_t>(indexCount), 0.0f});
+}
+
+/**
+ * @brief Constructor for Mesh from a compiled blob.
+ * Counts and dequantization parameters come from the blob header; the streams are read from the
+ * mapping at install time.
+ */
+Mesh::Mesh(std::string name, std::unique_ptr<MeshBlob> blob)
+        : name(std::move(name)), blob(std::move(blob)) {
+    const MeshBlob::Header &h = this->blob->GetHeader();
+    vertexCount = h.vertexCount;
+    indexCount = h.indexCount;
+    vertexData = this->blob->Vertices();
+    indexData = this->blob->Indices();
+    quantization = this->blob->GetQuantization();
+    lods = this->blob->GetLods();
+    boundingRadius = h.boundingRadius;
+}
+
+/**
+ * @brief Destructor for Mesh.
+ * Cleans up OpenGL buffers if they were created.
+ */
+Mesh::~Mesh() {
+    if (EBO) glDeleteBuffers(1, &EBO);
+    if (VBO) glDeleteBuffers(1, &VBO);
+    if (VAO) glDeleteVertexArrays(1, &VAO);
+}
+
+/**
+ * @fn Install
+ * @brief Sets up OpenGL buffers for rendering the mesh.
+ * This function creates a Vertex Array Object (VAO), Vertex Buffer Object (VBO) and
+ * Element Buffer Object (EBO), uploads the vertex and index data to the GPU,
+ * and configures normalized integer vertex attributes for the packed format.
+ * Blob-backed meshes upload directly from the mapping.
+ * The CPU copies and the mapping are released afterwards.
+ * @return True if the mesh is installed, false otherwise.
+ */
+bool Mesh::Install() {
+    if (VAO) return true;
+    if (vertexCount == 0 || indexCount == 0) {
+        Logger::Error("Cannot install empty mesh: " + name);
+        return false;
+    }
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(PackedVertex), vertexData, GL_STATIC_DRAW);
+    // The element buffer binding is part of the VAO state, so it must stay bound until the VAO is unbound
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indexData, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void *) offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void *) offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex),
+                          (void *) offsetof(PackedVertex, texCoord));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // The GPU owns the data now; drop the CPU copies and unmap the blob
+    std::vector<PackedVertex>().swap(packed);
+    std::vector<unsigned int>().swap(indices);
+    blob.reset();
+    vertexData = nullptr;
+    indexData = nullptr;
+    Logger::Info("Mesh installed: " + name + " (" + std::to_string(vertexCount * sizeof(PackedVertex)) +
+                 " vertex bytes)");
+    return true;
+}
+
+/**
+ * @fn Draw
+ * @brief Draws one level of detail of the mesh with the currently active shader.
+ */
+void Mesh::Draw(size_t lod) const {
+    if (!VAO || lods.empty()) return;
+    const Lod &level = lods[std::min(lod, lods.size() - 1)];
+    Shader *shader = Shader::GetActiveShader();
+    if (shader) {
+        shader->setBool("quantized", true);
+        shader->setVec3("positionOffset", quantization.positionOffset);
+        shader->setVec3("positionScale", quantization.positionScale);
+        shader->setVec2("texCoordOffset", quantization.texCoordOffset);
+        shader->setVec2("texCoordScale", quantization.texCoordScale);
+    }
+    glBindVertexArray(VAO);
+    glDrawElements(GL_TRIANGLES, (GLsizei) level.indexCount, GL_UNSIGNED_INT,
+                   (void *) (level.indexOffset * sizeof(unsigned int)));
+    glBindVertexArray(0);
+    if (shader) shader->setBool("quantized", false);
+}
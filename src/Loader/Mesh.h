@@ -0,0 +1,187 @@
+/**
+ * @file Mesh.h
+ * @brief Header file for the Mesh class.
+ * A Mesh owns indexed triangle geometry and the OpenGL buffers it is uploaded to.
+ * Meshes are shared between every ObjectLoader that uses the same geometry.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MESH_H
+#define BILLIARDSHOW_MESH_H
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MeshBlob;
+
+/**
+ * @class Mesh
+ * @brief Indexed triangle geometry with its VAO/VBO/EBO.
+ * Imported vertices are quantized into the compact PackedVertex format when the mesh is created.
+ * The index buffer holds one or more levels of detail (LODs) that all share the vertex buffer.
+ * The packed geometry lives either in CPU-side arrays or in a memory mapped MeshBlob;
+ * both are released once the mesh has been uploaded to the GPU.
+ */
+class Mesh {
+public:
+    // Maximum number of levels of detail per mesh, including the full detail level
+    static constexpr size_t MAX_LODS = 4;
+
+    /**
+     * @struct Vertex
+     * @brief Full precision vertex as produced by the importers (32 bytes).
+     */
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec2 texCoord;
+    };
+
+    /**
+     * @struct PackedVertex
+     * @brief Quantized vertex as stored on the GPU (16 bytes).
+     * Positions are 16-bit normalized against the mesh bounds, normals are octahedral-encoded
+     * into two 16-bit normalized values, and texcoords are 16-bit unsigned normalized against
+     * the texcoord bounds. The vertex shader dequantizes with the Quantization uniforms.
+     */
+    struct PackedVertex {
+        int16_t position[3];
+        int16_t padding;
+        int16_t normal[2];
+        uint16_t texCoord[2];
+    };
+
+    /**
+     * @struct Quantization
+     * @brief Maps packed values back to model space: value = offset + normalized * scale.
+     */
+    struct Quantization {
+        glm::vec3 positionOffset{0.0f};
+        glm::vec3 positionScale{1.0f};
+        glm::vec2 texCoordOffset{0.0f};
+        glm::vec2 texCoordScale{1.0f};
+    };
+
+    /**
+     * @struct Lod
+     * @brief Range of the index buffer that draws one level of detail.
+     */
+    struct Lod {
+        uint32_t indexOffset; // First index of the level
+        uint32_t indexCount;  // Number of indices of the level
+        float error;          // Geometric error relative to the bounding radius (0 for full detail)
+    };
+
+    /**
+     * @brief Quantizes full precision vertices into the packed format.
+     * @param vertices The vertices to pack.
+     * @param outPacked Receives one packed vertex per input vertex.
+     * @return The dequantization parameters for the packed vertices.
+     */
+    static Quantization Quantize(const std::vector<Vertex> &vertices, std::vector<PackedVertex> &outPacked);
+
+    /**
+     * @brief Creates a mesh from already indexed geometry, quantizing the vertices.
+     * @param name Name used in log messages, usually the source file path.
+     * @param vertices Unique vertices.
+     * @param indices Three vertex indices per triangle, all LODs one after another.
+     * @param lods Index ranges of the LODs, finest first; empty if the indices form a single level.
+     */
+    Mesh(std::string name, const std::vector<Vertex> &vertices, std::vector<unsigned int> indices,
+         std::vector<Lod> lods = {});
+
+    /**
+     * @brief Creates a mesh that uploads straight from a mapped blob.
+     * @param name Name used in log messages, usually the source file path.
+     * @param blob An opened blob; the mesh keeps it mapped until Install().
+     */
+    Mesh(std::string name, std::unique_ptr<MeshBlob> blob);
+
+    ~Mesh();
+
+    Mesh(const Mesh &) = delete;
+
+    Mesh &operator=(const Mesh &) = delete;
+
+    /**
+     * @brief Uploads the geometry to the GPU (VAO/VBO/EBO).
+     * Only the first call does any work, so every owner of a shared mesh may call it.
+     * Must be called on the thread that owns the OpenGL context.
+     * @return True if the mesh is installed.
+     */
+    bool Install();
+
+    /**
+     * @brief Issues the indexed draw call for one level of detail.
+     * Sets the dequantization uniforms on the active shader and clears the quantized flag again
+     * afterwards, so other geometry drawn with the same shader is unaffected.
+     * The caller is responsible for the remaining shader state (model matrix, textures).
+     * @param lod Level to draw; levels past the coarsest draw the coarsest.
+     */
+    void Draw(size_t lod = 0) const;
+
+    /**
+     * @brief Checks whether the mesh has been uploaded to the GPU.
+     * @return True after a successful Install().
+     */
+    bool IsInstalled() const { return VAO != 0; }
+
+    const std::string &GetName() const { return name; }
+
+    size_t GetVertexCount() const { return vertexCount; }
+
+    size_t GetIndexCount() const { return indexCount; }
+
+    glm::vec3 GetBoundsMin() const { return quantization.positionOffset - quantization.positionScale; }
+
+    glm::vec3 GetBoundsMax() const { return quantization.positionOffset + quantization.positionScale; }
+
+    /**
+     * @brief Gets the centre of the bounding sphere, which is the centre of the bounding box.
+     */
+    glm::vec3 GetBoundsCenter() const { return quantization.positionOffset; }
+
+    float GetBoundingRadius() const { return boundingRadius; }
+
+    size_t GetLodCount() const { return lods.size(); }
+
+    const Lod &GetLod(size_t lod) const { return lods[lod]; }
+
+    const std::vector<Lod> &GetLods() const { return lods; }
+
+    const Quantization &GetQuantization() const { return quantization; }
+
+    /**
+     * @brief Gets the CPU-side packed vertices, or an empty vector if the mesh came from a blob or is installed.
+     */
+    const std::vector<PackedVertex> &GetPackedVertices() const { return packed; }
+
+    /**
+     * @brief Gets the CPU-side indices, or an empty vector if the mesh came from a blob or is installed.
+     */
+    const std::vector<unsigned int> &GetIndices() const { return indices; }
+
+private:
+    std::string name;
+    std::vector<PackedVertex> packed;
+    std::vector<unsigned int> indices;
+    std::unique_ptr<MeshBlob> blob;
+    const PackedVertex *vertexData = nullptr; // Points into packed or the blob mapping
+    const unsigned int *indexData = nullptr;  // Points into indices or the blob mapping
+    Quantization quantization;
+    std::vector<Lod> lods;
+    float boundingRadius = 0.0f;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+};
+
+#endif //BILLIARDSHOW_MESH_H
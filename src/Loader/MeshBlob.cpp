@@ -0,0 +1,132 @@
+/**
+ * @file MeshBlob.cpp
+ * @brief Implementation of the MeshBlob class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MeshBlob.h"
+#include "../Utils/DerivedCache.h"
+#include "../Utils/Logger.h"
+
+#include <cstring>
+
+/**
+ * @fn alignUp
+ * @brief Rounds an offset up to the next multiple of 16 bytes.
+ */
+static uint32_t alignUp(size_t offset) {
+    return static_cast<uint32_t>((offset + 15) & ~size_t(15));
+}
+
+/**
+ * @fn KeyFor
+ * @brief Derives the cache key from the OBJ contents and the blob format version.
+ */
+uint64_t MeshBlob::KeyFor(uint64_t sourceHash) {
+    return DerivedCache::Key("mesh", VERSION, {sourceHash});
+}
+
+/**
+ * @fn Write
+ * @brief Compiles a mesh into a blob in the derived-asset cache.
+ * Layout: header, packed vertex stream, index stream (all LODs), material name; each stream starts
+ * on a 16-byte boundary.
+ */
+bool MeshBlob::Write(uint64_t key, uint64_t geometryHash, const std::string &materialFile, const Mesh &mesh) {
+    const std::vector<Mesh::PackedVertex> &vertices = mesh.GetPackedVertices();
+    const std::vector<unsigned int> &indices = mesh.GetIndices();
+    const Mesh::Quantization &quantization = mesh.GetQuantization();
+    if (vertices.empty() || indices.empty() || mesh.GetLodCount() > Mesh::MAX_LODS) {
+        Logger::Warn("Mesh has no CPU-side geometry to compile: " + mesh.GetName());
+        return false;
+    }
+    Header h = {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.vertexStride = sizeof(Mesh::PackedVertex);
+    h.vertexCount = static_cast<uint32_t>(vertices.size());
+    h.indexCount = static_cast<uint32_t>(indices.size());
+    h.vertexOffset = alignUp(sizeof(Header));
+    h.indexOffset = alignUp(h.vertexOffset + vertices.size() * sizeof(Mesh::PackedVertex));
+    h.materialOffset = alignUp(h.indexOffset + indices.size() * sizeof(unsigned int));
+    h.materialLength = static_cast<uint32_t>(materialFile.size());
+    h.geometryHash = geometryHash;
+    std::memcpy(h.positionOffset, &quantization.positionOffset.x, sizeof(h.positionOffset));
+    std::memcpy(h.positionScale, &quantization.positionScale.x, sizeof(h.positionScale));
+    std::memcpy(h.texCoordOffset, &quantization.texCoordOffset.x, sizeof(h.texCoordOffset));
+    std::memcpy(h.texCoordScale, &quantization.texCoordScale.x, sizeof(h.texCoordScale));
+    h.boundingRadius = mesh.GetBoundingRadius();
+    h.lodCount = static_cast<uint32_t>(mesh.GetLodCount());
+    for (size_t i = 0; i < mesh.GetLodCount(); ++i) h.lods[i] = mesh.GetLod(i);
+
+    std::vector<char> bytes(h.materialOffset + h.materialLength, 0);
+    std::memcpy(bytes.data(), &h, sizeof(h));
+    std::memcpy(bytes.data() + h.vertexOffset, vertices.data(), vertices.size() * sizeof(Mesh::PackedVertex));
+    std::memcpy(bytes.data() + h.indexOffset, indices.data(), indices.size() * sizeof(unsigned int));
+    std::memcpy(bytes.data() + h.materialOffset, materialFile.data(), materialFile.size());
+
+    if (!DerivedCache::Instance().Store(key, "mesh", {std::as_bytes(std::span(bytes))})) return false;
+    Logger::Info("Compiled mesh blob for " + mesh.GetName() + ": " + DerivedCache::Instance().PathFor(key, "mesh"));
+    return true;
+}
+
+/**
+ * @fn Open
+ * @brief Maps a blob and validates its header against the mapped size.
+ */
+bool MeshBlob::Open(uint64_t key) {
+    header = nullptr;
+    if (!DerivedCache::Instance().Open(key, "mesh", file)) return false;
+    path = DerivedCache::Instance().PathFor(key, "mesh");
+    if (file.Size() < sizeof(Header)) return false;
+    const auto *h = reinterpret_cast<const Header *>(file.Data());
+    if (h->magic != MAGIC || h->version != VERSION || h->vertexStride != sizeof(Mesh::PackedVertex)) {
+        Logger::Warn("Ignoring mesh blob with unknown format: " + path);
+        return false;
+    }
+    const uint64_t size = file.Size();
+    if (h->vertexOffset + uint64_t(h->vertexCount) * h->vertexStride > size ||
+        h->indexOffset + uint64_t(h->indexCount) * sizeof(unsigned int) > size ||
+        h->materialOffset + uint64_t(h->materialLength) > size) {
+        Logger::Warn("Ignoring truncated mesh blob: " + path);
+        return false;
+    }
+    if (h->lodCount == 0 || h->lodCount > Mesh::MAX_LODS) {
+        Logger::Warn("Ignoring mesh blob with invalid LOD table: " + path);
+        return false;
+    }
+    for (uint32_t i = 0; i < h->lodCount; ++i) {
+        if (uint64_t(h->lods[i].indexOffset) + h->lods[i].indexCount > h->indexCount) {
+            Logger::Warn("Ignoring mesh blob with invalid LOD table: " + path);
+            return false;
+        }
+    }
+    header = h;
+    return true;
+}
+
+const Mesh::PackedVertex *MeshBlob::Vertices() const {
+    return reinterpret_cast<const Mesh::PackedVertex *>(file.Data() + header->vertexOffset);
+}
+
+Mesh::Quantization MeshBlob::GetQuantization() const {
+    Mesh::Quantization q;
+    q.positionOffset = glm::vec3(header->positionOffset[0], header->positionOffset[1], header->positionOffset[2]);
+    q.positionScale = glm::vec3(header->positionScale[0], header->positionScale[1], header->positionScale[2]);
+    q.texCoordOffset = glm::vec2(header->texCoordOffset[0], header->texCoordOffset[1]);
+    q.texCoordScale = glm::vec2(header->texCoordScale[0], header->texCoordScale[1]);
+    return q;
+}
+
+std::vector<Mesh::Lod> MeshBlob::GetLods() const {
+    return std::vector<Mesh::Lod>(header->lods, header->lods + header->lodCount);
+}
+
+const unsigned int *MeshBlob::Indices() const {
+    return reinterpret_cast<const unsigned int *>(file.Data() + header->indexOffset);
+}
+
+std::string MeshBlob::MaterialFile() const {
+    return std::string(file.Data() + header->materialOffset, header->materialLength);
+}
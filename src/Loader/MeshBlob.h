@@ -0,0 +1,98 @@
+/**
+ * @file MeshBlob.h
+ * @brief Header file for the MeshBlob class.
+ * A mesh blob is the compiled binary form of an OBJ file: a fixed header followed by the
+ * packed vertex stream, the index stream and the material file name. Blobs are stored in the
+ * derived-asset cache under a key of the OBJ file's contents the first time the file is parsed,
+ * and are memory mapped on later runs so the GPU upload reads straight from the mapping.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MESHBLOB_H
+#define BILLIARDSHOW_MESHBLOB_H
+
+#pragma once
+
+#include "Mesh.h"
+#include "../Utils/MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class MeshBlob
+ * @brief Reads and writes compiled binary meshes.
+ * The key covers the whole OBJ file, so an edited file misses and the caller falls back to
+ * the OBJ and compiles a new blob.
+ */
+class MeshBlob {
+public:
+    static constexpr uint32_t MAGIC = 0x424D5342; // "BSMB" in little-endian byte order
+    static constexpr uint32_t VERSION = 5;
+
+    /**
+     * @struct Header
+     * @brief On-disk header; all offsets are in bytes from the start of the blob.
+     */
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexStride;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t vertexOffset;
+        uint32_t indexOffset;
+        uint32_t materialOffset;
+        uint32_t materialLength;
+        uint32_t lodCount;
+        uint64_t geometryHash;   // MeshCache key of the geometry
+        float positionOffset[3]; // Dequantization parameters, see Mesh::Quantization
+        float positionScale[3];
+        float texCoordOffset[2];
+        float texCoordScale[2];
+        float boundingRadius;
+        Mesh::Lod lods[Mesh::MAX_LODS]; // First lodCount entries are used
+    };
+
+    /**
+     * @brief Gets the cache key of the blob compiled from an OBJ file.
+     * @param sourceHash XXH64 of the whole OBJ file.
+     */
+    static uint64_t KeyFor(uint64_t sourceHash);
+
+    /**
+     * @brief Compiles a mesh into a blob in the derived-asset cache.
+     * @param key The key from KeyFor().
+     * @param geometryHash MeshCache key of the geometry, so a cached blob finds meshes to share.
+     * @param mesh A mesh that still has its CPU-side geometry (not created from a blob, not installed).
+     * @return True if the blob was written.
+     */
+    static bool Write(uint64_t key, uint64_t geometryHash, const std::string &materialFile, const Mesh &mesh);
+
+    /**
+     * @brief Maps a blob from the derived-asset cache and validates its header.
+     * @return False if the blob is missing, truncated, or from another format version.
+     */
+    bool Open(uint64_t key);
+
+    const Header &GetHeader() const { return *header; }
+
+    const Mesh::PackedVertex *Vertices() const;
+
+    Mesh::Quantization GetQuantization() const;
+
+    std::vector<Mesh::Lod> GetLods() const;
+
+    const unsigned int *Indices() const;
+
+    std::string MaterialFile() const;
+
+private:
+    MappedFile file;
+    std::string path; // Cache file, for log messages
+    const Header *header = nullptr;
+};
+
+#endif //BILLIARDSHOW_MESHBLOB_H
@@ -0,0 +1,237 @@
+/**
+ * @file MeshCache.cpp
+ * @brief Implementation of the MeshCache class.
+ * Hashes the geometry of OBJ files and hands out shared Mesh instances,
+ * preferring compiled mesh blobs over parsing the OBJ text.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MeshCache.h"
+#include "MeshBlob.h"
+#include "MeshGenerator.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjectLoader.h"
+#include "../Utils/Hash.h"
+#include "../Utils/Logger.h"
+#include "../Utils/AssetArchive.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @fn isMaterialStatement
+ * @brief Checks whether a line starts with an mtllib or usemtl statement.
+ */
+static bool isMaterialStatement(const char *p, const char *lineEnd) {
+    if (lineEnd - p < 7) return false;
+    return (std::memcmp(p, "mtllib", 6) == 0 || std::memcmp(p, "usemtl", 6) == 0) && (p[6] == ' ' || p[6] == '\t');
+}
+
+/**
+ * @fn hashGeometry
+ * @brief Hashes an OBJ buffer with its material statements left out.
+ * Material lines are rare, so the buffer is hashed in a few large runs between them.
+ * @param data Start of the OBJ text.
+ * @param size Size of the OBJ text in bytes.
+ * @return The geometry hash.
+ */
+static uint64_t hashGeometry(const char *data, size_t size) {
+    const char *p = data;
+    const char *end = data + size;
+    const char *runStart = p;
+    uint64_t hash = 0;
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        const char *next = eol ? eol + 1 : end;
+        if (isMaterialStatement(p, eol ? eol : end)) {
+            hash = Hash::XXH64(runStart, p - runStart, hash);
+            runStart = next;
+        }
+        p = next;
+    }
+    return Hash::XXH64(runStart, end - runStart, hash);
+}
+
+/**
+ * @fn importOBJ
+ * @brief Builds a mesh from in-memory OBJ text.
+ * The parsed geometry is optimized for drawing and gets its simplified LODs appended.
+ * @return The mesh, or nullptr if the OBJ could not be parsed.
+ */
+static std::shared_ptr<Mesh> importOBJ(const AssetFile &file, const std::string &path, std::string &outMtlFile) {
+    std::vector<Mesh::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    if (!parseOBJ(file.Data(), file.Size(), path, vertices, indices, outMtlFile)) return nullptr;
+    MeshOptimizer::Optimize(vertices, indices, path);
+    std::vector<Mesh::Lod> lods;
+    MeshSimplifier::BuildLodChain(vertices, indices, lods, path);
+    return std::make_shared<Mesh>(path, vertices, std::move(indices), std::move(lods));
+}
+
+MeshCache &MeshCache::Instance() {
+    static MeshCache instance;
+    return instance;
+}
+
+/**
+ * @fn Acquire
+ * @brief Returns the shared mesh for an OBJ file, parsing it only if its geometry is new.
+ * The OBJ is opened once (from the asset archive or as a mapped loose file) and hashed; a cached
+ * blob for that hash is used without parsing any text. Otherwise the geometry is hashed, imported
+ * on a miss, and compiled into a new blob for the next run.
+ */
+std::shared_ptr<Mesh> MeshCache::Acquire(const std::string &objPath, std::string &outMtlFile) {
+    AssetFile file;
+    if (!file.Open(objPath)) {
+        Logger::Error("Failed to open OBJ file: " + objPath);
+        return nullptr;
+    }
+    const uint64_t blobKey = MeshBlob::KeyFor(Hash::XXH64(file.Data(), file.Size()));
+
+    // Fast path: the file was compiled before, so no text is parsed
+    auto blob = std::make_unique<MeshBlob>();
+    if (blob->Open(blobKey)) {
+        outMtlFile = blob->MaterialFile();
+        const uint64_t key = blob->GetHeader().geometryHash;
+        bool created = false;
+        std::shared_ptr<Mesh> mesh = GetOrCreate(key, [&]() {
+            return std::make_shared<Mesh>(objPath, std::move(blob));
+        }, created);
+        if (mesh && !created) Logger::Info("Reusing cached mesh " + mesh->GetName() + " for " + objPath);
+        if (mesh) RememberPath(objPath, key);
+        return mesh;
+    }
+
+    // Slow path: no blob for this version of the file, fall back to the OBJ text
+    const uint64_t key = hashGeometry(file.Data(), file.Size());
+    bool created = false;
+    std::shared_ptr<Mesh> mesh = GetOrCreate(key, [&]() {
+        return importOBJ(file, objPath, outMtlFile);
+    }, created);
+    if (!mesh) return nullptr;
+    RememberPath(objPath, key);
+    if (!created) {
+        // Only the material name is needed from a file whose geometry is already cached
+        parseOBJMaterial(file.Data(), file.Size(), outMtlFile);
+        Logger::Info("Reusing cached mesh " + mesh->GetName() + " for " + objPath);
+    }
+
+    // Compile the blob for the next run. Loading happens before any mesh is installed,
+    // so the shared mesh normally still has its CPU data; if it came from another blob, import locally.
+    if (!mesh->GetPackedVertices().empty()) {
+        MeshBlob::Write(blobKey, key, outMtlFile, *mesh);
+    } else {
+        std::string mtlFile;
+        std::shared_ptr<Mesh> local = importOBJ(file, objPath, mtlFile);
+        if (local) MeshBlob::Write(blobKey, key, mtlFile, *local);
+    }
+    return mesh;
+}
+
+/**
+ * @fn AcquireSphere
+ * @brief Returns the shared procedural sphere of a tessellation.
+ * Generated meshes share the key space with OBJ geometry, so the key hashes a descriptor string
+ * that no OBJ file hashes to in practice.
+ */
+std::shared_ptr<Mesh> MeshCache::AcquireSphere(int segments) {
+    if (segments < 3) return nullptr;
+    const std::string descriptor = "procedural:uvsphere:" + std::to_string(segments);
+    bool created = false;
+    std::shared_ptr<Mesh> mesh = GetOrCreate(Hash::XXH64(descriptor.data(), descriptor.size()), [&]() {
+        return MeshGenerator::Sphere(segments, "sphere" + std::to_string(segments));
+    }, created);
+    if (mesh && !created) Logger::Info("Reusing cached mesh " + mesh->GetName());
+    return mesh;
+}
+
+/**
+ * @fn Reload
+ * @brief Imports an OBJ file without consulting the mesh cache or the blobs.
+ * The new mesh is stored under its geometry key, so later loads of the same geometry share it.
+ * The entry of the file's previous geometry is dropped unless another file still has that
+ * geometry, so an edited mesh does not stay cached for the rest of the run.
+ */
+std::shared_ptr<Mesh> MeshCache::Reload(const std::string &objPath) {
+    AssetFile file;
+    if (!file.Open(objPath)) {
+        Logger::Error("Failed to open OBJ file: " + objPath);
+        return nullptr;
+    }
+    std::string mtlFile;
+    std::shared_ptr<Mesh> mesh = importOBJ(file, objPath, mtlFile);
+    if (!mesh) return nullptr;
+    const uint64_t key = hashGeometry(file.Data(), file.Size());
+    MeshBlob::Write(MeshBlob::KeyFor(Hash::XXH64(file.Data(), file.Size())), key, mtlFile, *mesh);
+    std::promise<std::shared_ptr<Mesh>> promise;
+    promise.set_value(mesh);
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[key] = promise.get_future().share();
+    const std::string normalized = AssetArchive::NormalizePath(objPath);
+    auto previous = pathKeys.find(normalized);
+    if (previous != pathKeys.end() && previous->second != key) {
+        const uint64_t oldKey = previous->second;
+        previous->second = key;
+        const bool shared = std::any_of(pathKeys.begin(), pathKeys.end(), [oldKey](const auto &entry) {
+            return entry.second == oldKey;
+        });
+        if (!shared) entries.erase(oldKey);
+    } else {
+        pathKeys[normalized] = key;
+    }
+    return mesh;
+}
+
+/**
+ * @fn RememberPath
+ * @brief Records which geometry key a file was last loaded as, for Reload() to drop it later.
+ */
+void MeshCache::RememberPath(const std::string &objPath, uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pathKeys[AssetArchive::NormalizePath(objPath)] = key;
+}
+
+/**
+ * @fn GetOrCreate
+ * @brief Looks up a mesh by key, or creates it with the given function if no one has yet.
+ * The creation runs outside the lock; callers asking for the same key meanwhile wait on its future.
+ * A failed creation is forgotten so a later request can retry.
+ */
+std::shared_ptr<Mesh> MeshCache::GetOrCreate(uint64_t key, const std::function<std::shared_ptr<Mesh>()> &create,
+                                             bool &outCreated) {
+    std::promise<std::shared_ptr<Mesh>> promise;
+    std::shared_future<std::shared_ptr<Mesh>> future;
+    outCreated = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            future = it->second;
+        } else {
+            future = promise.get_future().share();
+            entries.emplace(key, future);
+            outCreated = true;
+        }
+    }
+    if (!outCreated) return future.get();
+
+    std::shared_ptr<Mesh> mesh = create();
+    if (!mesh) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.erase(key);
+    }
+    promise.set_value(mesh);
+    return mesh;
+}
+
+/**
+ * @fn Clear
+ * @brief Drops the cache's references to all meshes.
+ */
+void MeshCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    pathKeys.clear();
+}
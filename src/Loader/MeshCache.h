@@ -0,0 +1,84 @@
+/**
+ * @file MeshCache.h
+ * @brief Header file for the MeshCache class.
+ * A process-wide registry of loaded meshes keyed by a hash of their geometry,
+ * so files that differ only in their material references share one parsed and uploaded mesh.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MESHCACHE_H
+#define BILLIARDSHOW_MESHCACHE_H
+
+#pragma once
+
+#include "Mesh.h"
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class MeshCache
+ * @brief Shares Mesh instances between all users of identical geometry.
+ * The key is a hash of the OBJ contents with material statements (mtllib/usemtl) removed;
+ * compiled mesh blobs record the key, so a cached blob is matched without parsing its OBJ. Concurrent requests for the same geometry parse it only once; the other callers
+ * wait for the first parse to finish.
+ */
+class MeshCache {
+public:
+    /**
+     * @brief Gets the process-wide cache instance.
+     */
+    static MeshCache &Instance();
+
+    /**
+     * @brief Returns the shared mesh for an OBJ file, parsing it only if its geometry is new.
+     * Safe to call from several threads at once.
+     * @param objPath Path to the OBJ file.
+     * @param outMtlFile Receives the file's own mtllib name, which is not part of the shared mesh.
+     * @return The shared mesh, or nullptr if the file could not be read or parsed.
+     */
+    std::shared_ptr<Mesh> Acquire(const std::string &objPath, std::string &outMtlFile);
+
+    /**
+     * @brief Returns the shared procedural UV sphere with the given tessellation, generating it on first use.
+     * Safe to call from several threads at once.
+     * @param segments Segments around the sphere's axis of the full detail level.
+     * @return The shared mesh, or nullptr for fewer than 3 segments.
+     */
+    std::shared_ptr<Mesh> AcquireSphere(int segments);
+
+    /**
+     * @brief Imports an OBJ file again after it changed, compiling its blob and replacing its cache entry.
+     * Meshes already handed out are not touched; their users swap in the returned mesh, and the
+     * previous mesh is freed once the last of them has.
+     * @param objPath Path to the OBJ file.
+     * @return The new mesh, not yet installed, or nullptr if the file could not be read or parsed.
+     */
+    std::shared_ptr<Mesh> Reload(const std::string &objPath);
+
+    /**
+     * @brief Drops the cache's references to all meshes.
+     * Meshes still held by an ObjectLoader stay alive until it releases them.
+     */
+    void Clear();
+
+private:
+    MeshCache() = default;
+
+    std::shared_ptr<Mesh> GetOrCreate(uint64_t key, const std::function<std::shared_ptr<Mesh>()> &create,
+                                      bool &outCreated);
+
+    void RememberPath(const std::string &objPath, uint64_t key);
+
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_future<std::shared_ptr<Mesh>>> entries;
+    std::unordered_map<std::string, uint64_t> pathKeys; // Geometry key each OBJ file was last loaded as
+};
+
+#endif //BILLIARDSHOW_MESHCACHE_H
@@ -0,0 +1,84 @@
+/**
+ * @file MeshGenerator.cpp
+ * @brief Implementation of the procedural mesh generators.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MeshGenerator.h"
+#include "MeshOptimizer.h"
+#include "../Utils/Logger.h"
+
+#include <cmath>
+#include <cstdio>
+
+void MeshGenerator::UVSphere(int segments, int rings, std::vector<Mesh::Vertex> &outVertices,
+                             std::vector<unsigned int> &outIndices) {
+    const float pi = 3.14159265358979f;
+    outVertices.clear();
+    outIndices.clear();
+    outVertices.reserve((size_t) (rings - 1) * (segments + 1) + 2 * (size_t) segments);
+    outIndices.reserve((size_t) segments * (rings - 1) * 6);
+
+    // Interior rings; column `segments` repeats column 0 with u = 1 to close the seam
+    for (int i = 1; i < rings; ++i) {
+        const float theta = pi * (float) i / (float) rings;
+        const float y = std::cos(theta), r = std::sin(theta);
+        const float v = 1.0f - (float) i / (float) rings;
+        for (int j = 0; j <= segments; ++j) {
+            const float u = (float) j / (float) segments;
+            const float phi = 2.0f * pi * (SPHERE_U_OFFSET - u);
+            const glm::vec3 p(r * std::cos(phi), y, r * std::sin(phi));
+            outVertices.push_back({p, p, glm::vec2(u, v)});
+        }
+    }
+    auto ring = [segments](int i, int j) { return (unsigned int) ((i - 1) * (segments + 1) + j); };
+
+    // One pole vertex per segment, at the centre u of that segment
+    const auto north = (unsigned int) outVertices.size();
+    for (int j = 0; j < segments; ++j)
+        outVertices.push_back({glm::vec3(0, 1, 0), glm::vec3(0, 1, 0), glm::vec2((j + 0.5f) / segments, 1.0f)});
+    const auto south = (unsigned int) outVertices.size();
+    for (int j = 0; j < segments; ++j)
+        outVertices.push_back({glm::vec3(0, -1, 0), glm::vec3(0, -1, 0), glm::vec2((j + 0.5f) / segments, 0.0f)});
+
+    // phi falls as u grows, so (upper j, lower j, lower j + 1) winds counter-clockwise seen from outside
+    for (int j = 0; j < segments; ++j) {
+        outIndices.insert(outIndices.end(), {north + j, ring(1, j), ring(1, j + 1)});
+        for (int i = 1; i < rings - 1; ++i) {
+            outIndices.insert(outIndices.end(), {ring(i, j), ring(i + 1, j), ring(i + 1, j + 1)});
+            outIndices.insert(outIndices.end(), {ring(i, j), ring(i + 1, j + 1), ring(i, j + 1)});
+        }
+        outIndices.insert(outIndices.end(), {ring(rings - 1, j), south + j, ring(rings - 1, j + 1)});
+    }
+}
+
+std::shared_ptr<Mesh> MeshGenerator::Sphere(int segments, const std::string &name) {
+    const float pi = 3.14159265358979f;
+    std::vector<Mesh::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    UVSphere(segments, segments, vertices, indices);
+    MeshOptimizer::Optimize(vertices, indices, name);
+
+    std::vector<Mesh::Lod> lods;
+    lods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+    std::string report = std::to_string(indices.size() / 3);
+    std::vector<Mesh::Vertex> levelVertices;
+    std::vector<unsigned int> levelIndices;
+    for (int s = segments / 2; s >= MIN_SPHERE_SEGMENTS && lods.size() < Mesh::MAX_LODS; s /= 2) {
+        UVSphere(s, s, levelVertices, levelIndices);
+        MeshOptimizer::OptimizeVertexCache(levelIndices, levelVertices.size());
+        const auto base = static_cast<unsigned int>(vertices.size());
+        for (auto &index: levelIndices) index += base;
+        // A facet's centre sits about sin^2(pi / s) below the unit sphere
+        const float error = std::sin(pi / (float) s) * std::sin(pi / (float) s);
+        lods.push_back({static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(levelIndices.size()), error});
+        vertices.insert(vertices.end(), levelVertices.begin(), levelVertices.end());
+        indices.insert(indices.end(), levelIndices.begin(), levelIndices.end());
+        char buffer[48];
+        std::snprintf(buffer, sizeof(buffer), ", %zu (error %.4f)", levelIndices.size() / 3, error);
+        report += buffer;
+    }
+    Logger::Info("Generated " + std::to_string(lods.size()) + " LODs for " + name + ": " + report + " triangles");
+    return std::make_shared<Mesh>(name, vertices, std::move(indices), std::move(lods));
+}
@@ -0,0 +1,52 @@
+/**
+ * @file MeshGenerator.h
+ * @brief Procedural meshes that replace imported geometry where the shape is known analytically.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MESHGENERATOR_H
+#define BILLIARDSHOW_MESHGENERATOR_H
+
+#pragma once
+
+#include "Mesh.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MeshGenerator {
+    // Texture u of the +X axis in the PoolBalluv layout; u decreases counter-clockwise seen from +Y
+    constexpr float SPHERE_U_OFFSET = 0.765625f;
+
+    // Coarsest tessellation a generated LOD may use
+    constexpr int MIN_SPHERE_SEGMENTS = 8;
+
+    /**
+     * @brief Generates a unit UV sphere centred on the origin with the PoolBalluv texture layout.
+     * Rings run from the +Y pole (v = 1) to the -Y pole (v = 0); the texture seam gets duplicated
+     * vertices at u = 0 and u = 1, and every pole triangle has its own pole vertex at the centre u
+     * of its segment, so no triangle interpolates across the seam or collapses its texture at the pole.
+     * With 64 segments and 64 rings this reproduces the positions and texture coordinates of the BallN.obj files.
+     * @param segments Number of segments around the Y axis (at least 3).
+     * @param rings Number of rings from pole to pole (at least 2).
+     * @param outVertices Receives the vertices.
+     * @param outIndices Receives the counter-clockwise, outward facing triangle list.
+     */
+    void UVSphere(int segments, int rings, std::vector<Mesh::Vertex> &outVertices,
+                  std::vector<unsigned int> &outIndices);
+
+    /**
+     * @brief Builds a drawable sphere mesh with a LOD chain.
+     * LOD 0 has the given tessellation and is fully optimized; each further level halves the
+     * segments and rings (a quarter of the triangles, like MeshSimplifier's chain) down to
+     * MIN_SPHERE_SEGMENTS, with its vertices appended to the shared vertex buffer.
+     * @param segments Segments around the Y axis of LOD 0; rings are the same number.
+     * @param name Name of the mesh, used in logs.
+     * @return The mesh, not yet installed.
+     */
+    std::shared_ptr<Mesh> Sphere(int segments, const std::string &name);
+}
+
+#endif //BILLIARDSHOW_MESHGENERATOR_H
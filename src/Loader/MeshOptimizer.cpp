@@ -0,0 +1,264 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @brief Implementation of the mesh optimization passes.
+ * All passes run in (near) linear time so they can be part of the OBJ import path.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MeshOptimizer.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <numeric>
+
+/**
+ * @fn simulateCache
+ * @brief Runs a FIFO vertex cache over a triangle list.
+ * A vertex is cached if it was inserted by one of the last cacheSize misses.
+ * @param outTriangleMisses Receives the number of misses of every triangle, if not null.
+ * @return The total number of misses.
+ */
+static unsigned int simulateCache(const std::vector<unsigned int> &indices, size_t vertexCount, unsigned int cacheSize,
+                                  std::vector<unsigned char> *outTriangleMisses) {
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    unsigned int timestamp = cacheSize + 1;
+    unsigned int misses = 0;
+    if (outTriangleMisses) outTriangleMisses->assign(indices.size() / 3, 0);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        for (size_t c = 0; c < 3; ++c) {
+            unsigned int v = indices[i + c];
+            if (timestamp - cacheTime[v] > cacheSize) {
+                cacheTime[v] = timestamp++;
+                ++misses;
+                if (outTriangleMisses) ++(*outTriangleMisses)[i / 3];
+            }
+        }
+    }
+    return misses;
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<unsigned int> &indices,
+                                                            size_t vertexCount, unsigned int cacheSize) {
+    CacheStats stats;
+    if (indices.size() < 3) return stats;
+    stats.transformed = simulateCache(indices, vertexCount, cacheSize, nullptr);
+
+    std::vector<bool> referenced(vertexCount, false);
+    size_t unique = 0;
+    for (unsigned int v: indices) {
+        if (!referenced[v]) {
+            referenced[v] = true;
+            ++unique;
+        }
+    }
+    stats.acmr = (float) stats.transformed / (float) (indices.size() / 3);
+    stats.atvr = (float) stats.transformed / (float) unique;
+    return stats;
+}
+
+/**
+ * @fn OptimizeVertexCache
+ * @brief Tipsify: fans out around one vertex at a time, emitting all its remaining triangles,
+ * then continues with the adjacent vertex that will still be cached longest. When no candidate
+ * is live, it falls back to recently used vertices (dead-end stack) and finally to input order.
+ */
+void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int> &indices, size_t vertexCount,
+                                        unsigned int cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    // Vertex to triangle adjacency, stored as one array with per-vertex offsets
+    std::vector<unsigned int> liveCount(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) ++liveCount[indices[i]];
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + liveCount[v];
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    {
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) adjacency[fill[indices[i]]++] = (unsigned int) (i / 3);
+    }
+
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> deadEnd;
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> result;
+    result.reserve(triangleCount * 3);
+    unsigned int timestamp = cacheSize + 1;
+    size_t cursor = 0;
+    long long fan = indices[0];
+
+    while (fan >= 0) {
+        candidates.clear();
+        for (unsigned int a = offsets[fan]; a < offsets[fan + 1]; ++a) {
+            unsigned int t = adjacency[a];
+            if (emitted[t]) continue;
+            for (size_t c = 0; c < 3; ++c) {
+                unsigned int v = indices[t * 3 + c];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --liveCount[v];
+                if (timestamp - cacheTime[v] > cacheSize) cacheTime[v] = timestamp++;
+            }
+            emitted[t] = true;
+        }
+
+        // Prefer the candidate that stays in the cache while its remaining triangles are emitted
+        long long next = -1;
+        long long bestPriority = -1;
+        for (unsigned int v: candidates) {
+            if (liveCount[v] == 0) continue;
+            long long priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveCount[v] <= cacheSize) priority = timestamp - cacheTime[v];
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+        if (next < 0) {
+            while (!deadEnd.empty()) {
+                unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveCount[v] > 0) {
+                    next = v;
+                    break;
+                }
+            }
+        }
+        if (next < 0) {
+            while (cursor < vertexCount && liveCount[cursor] == 0) ++cursor;
+            if (cursor < vertexCount) next = (long long) cursor;
+        }
+        fan = next;
+    }
+    indices.swap(result);
+}
+
+/**
+ * @fn OptimizeOverdraw
+ * @brief Cuts the triangle list into clusters and draws the outward facing ones first.
+ * Hard cuts go where a triangle misses on all three vertices (the cache restarted anyway);
+ * soft cuts go inside a hard cluster once the running ACMR has dropped to threshold times the
+ * cluster's ACMR, so a cut costs little. Clusters are sorted by the distance of their
+ * centroid from the mesh centroid along their average normal.
+ */
+void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Mesh::Vertex> &vertices,
+                                     float threshold, unsigned int cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return;
+
+    std::vector<unsigned char> misses;
+    const unsigned int baseMisses = simulateCache(indices, vertices.size(), cacheSize, &misses);
+
+    std::vector<size_t> hard;
+    for (size_t t = 0; t < triangleCount; ++t)
+        if (t == 0 || misses[t] == 3) hard.push_back(t);
+    hard.push_back(triangleCount);
+
+    std::vector<size_t> clusters;
+    for (size_t h = 0; h + 1 < hard.size(); ++h) {
+        const size_t begin = hard[h], end = hard[h + 1];
+        unsigned int clusterMisses = 0;
+        for (size_t t = begin; t < end; ++t) clusterMisses += misses[t];
+        const float limit = threshold * (float) clusterMisses / (float) (end - begin);
+
+        clusters.push_back(begin);
+        unsigned int runMisses = 0;
+        size_t runTriangles = 0;
+        for (size_t t = begin; t + 1 < end; ++t) {
+            runMisses += misses[t];
+            ++runTriangles;
+            if ((float) runMisses <= limit * (float) runTriangles) {
+                clusters.push_back(t + 1);
+                runMisses = 0;
+                runTriangles = 0;
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+    const size_t clusterCount = clusters.size() - 1;
+    if (clusterCount < 2) return;
+
+    // Area weighted centroid and normal per cluster, and of the whole mesh
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+    std::vector<float> areas(clusterCount, 0.0f);
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; ++c) {
+        for (size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+            const glm::vec3 &p0 = vertices[indices[t * 3 + 0]].position;
+            const glm::vec3 &p1 = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3 &p2 = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(n);
+            centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[c] += n;
+            areas[c] += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += areas[c];
+    }
+    if (meshArea <= 0.0f) return;
+    meshCentroid = meshCentroid / meshArea;
+
+    std::vector<float> keys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        float len = glm::length(normals[c]);
+        if (areas[c] <= 0.0f || len <= 0.0f) continue;
+        keys[c] = glm::dot(centroids[c] / areas[c] - meshCentroid, normals[c] / len);
+    }
+    std::vector<size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] > keys[b]; });
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (size_t c: order)
+        result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+
+    // The cuts are estimated; keep the cache order if the clustering cost more than allowed
+    const unsigned int newMisses = simulateCache(result, vertices.size(), cacheSize, nullptr);
+    if ((float) newMisses > threshold * (float) baseMisses) return;
+    indices.swap(result);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Mesh::Vertex> &vertices, std::vector<unsigned int> &indices) {
+    std::vector<unsigned int> remap(vertices.size(), UINT_MAX);
+    std::vector<Mesh::Vertex> result;
+    result.reserve(vertices.size());
+    for (unsigned int &index: indices) {
+        if (remap[index] == UINT_MAX) {
+            remap[index] = (unsigned int) result.size();
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(result);
+}
+
+/**
+ * @fn formatStats
+ * @brief Formats cache statistics for the optimization report.
+ */
+static std::string formatStats(const MeshOptimizer::CacheStats &stats) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "ACMR %.3f, ATVR %.3f", stats.acmr, stats.atvr);
+    return buffer;
+}
+
+void MeshOptimizer::Optimize(std::vector<Mesh::Vertex> &vertices, std::vector<unsigned int> &indices,
+                             const std::string &name) {
+    if (indices.size() < 3) return;
+    const CacheStats before = AnalyzeVertexCache(indices, vertices.size());
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+    const CacheStats after = AnalyzeVertexCache(indices, vertices.size());
+    Logger::Info("Optimized mesh " + name + " (cache " + std::to_string(DEFAULT_CACHE_SIZE) + "): " +
+                 formatStats(before) + " -> " + formatStats(after));
+}
@@ -0,0 +1,297 @@
+/**
+ * @file MeshSimplifier.cpp
+ * @brief Implementation of the quadric error mesh simplifier.
+ * Based on Garland and Heckbert, "Surface Simplification Using Quadric Error Metrics",
+ * restricted to half-edge collapses so simplified levels can share the original vertex buffer.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+/**
+ * @struct Quadric
+ * @brief Symmetric 4x4 matrix measuring the summed squared distance of a point to a set of planes.
+ */
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a11 = 0, a12 = 0, a13 = 0;
+    double a22 = 0, a23 = 0;
+    double a33 = 0;
+
+    void AddPlane(const glm::vec3 &n, double d, double w) {
+        a00 += w * n.x * n.x;
+        a01 += w * n.x * n.y;
+        a02 += w * n.x * n.z;
+        a03 += w * n.x * d;
+        a11 += w * n.y * n.y;
+        a12 += w * n.y * n.z;
+        a13 += w * n.y * d;
+        a22 += w * n.z * n.z;
+        a23 += w * n.z * d;
+        a33 += w * d * d;
+    }
+
+    void Add(const Quadric &q) {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a03 += q.a03;
+        a11 += q.a11;
+        a12 += q.a12;
+        a13 += q.a13;
+        a22 += q.a22;
+        a23 += q.a23;
+        a33 += q.a33;
+    }
+
+    double Evaluate(const glm::vec3 &p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        double e = a00 * x * x + a11 * y * y + a22 * z * z + a33 +
+                   2.0 * (a01 * x * y + a02 * x * z + a12 * y * z + a03 * x + a13 * y + a23 * z);
+        return e > 0.0 ? e : 0.0;
+    }
+};
+
+/**
+ * @struct Collapse
+ * @brief Cheapest half-edge collapse found for a vertex.
+ */
+struct Collapse {
+    unsigned int from;
+    unsigned int to;
+    double cost;
+};
+
+/**
+ * @fn buildPositionIds
+ * @brief Gives vertices with bitwise equal positions the same id, so seams can be detected.
+ * @return The number of distinct positions.
+ */
+static unsigned int buildPositionIds(const std::vector<Mesh::Vertex> &vertices, std::vector<unsigned int> &outIds) {
+    std::vector<unsigned int> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0u);
+    auto less = [&](unsigned int a, unsigned int b) {
+        const glm::vec3 &p = vertices[a].position, &q = vertices[b].position;
+        if (p.x != q.x) return p.x < q.x;
+        if (p.y != q.y) return p.y < q.y;
+        return p.z < q.z;
+    };
+    std::sort(order.begin(), order.end(), less);
+    outIds.assign(vertices.size(), 0);
+    unsigned int id = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && less(order[i - 1], order[i])) ++id;
+        outIds[order[i]] = id;
+    }
+    return vertices.empty() ? 0 : id + 1;
+}
+
+/**
+ * @fn triangleNormal
+ * @brief Unnormalized normal of a triangle; its length is twice the area.
+ */
+static glm::vec3 triangleNormal(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c) {
+    return glm::cross(b - a, c - a);
+}
+
+float MeshSimplifier::Simplify(const std::vector<Mesh::Vertex> &vertices, const std::vector<unsigned int> &indices,
+                               size_t targetIndexCount, float maxError, std::vector<unsigned int> &outIndices) {
+    outIndices = indices;
+    if (indices.size() <= targetIndexCount || vertices.empty()) return 0.0f;
+
+    // Work in a frame where the bounding radius is 1, so errors are relative
+    glm::vec3 lo = vertices[0].position, hi = vertices[0].position;
+    for (const auto &v: vertices) {
+        lo = glm::min(lo, v.position);
+        hi = glm::max(hi, v.position);
+    }
+    const glm::vec3 center = (lo + hi) * 0.5f;
+    float radius = 0.0f;
+    for (const auto &v: vertices) radius = std::max(radius, glm::length(v.position - center));
+    if (radius <= 0.0f) return 0.0f;
+    std::vector<glm::vec3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) positions[i] = (vertices[i].position - center) / radius;
+
+    std::vector<unsigned int> positionId;
+    const unsigned int positionCount = buildPositionIds(vertices, positionId);
+
+    // Lock seams: positions used by more than one referenced vertex
+    std::vector<unsigned int> firstVertex(positionCount, UINT32_MAX);
+    std::vector<bool> locked(vertices.size(), false);
+    std::vector<bool> positionLocked(positionCount, false);
+    for (unsigned int v: indices) {
+        unsigned int p = positionId[v];
+        if (firstVertex[p] == UINT32_MAX) firstVertex[p] = v;
+        else if (firstVertex[p] != v) positionLocked[p] = true;
+    }
+
+    // Lock open borders and non-manifold edges: position edges not shared by exactly two triangles
+    std::vector<uint64_t> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        for (size_t c = 0; c < 3; ++c) {
+            uint64_t a = positionId[indices[i + c]], b = positionId[indices[i + (c + 1) % 3]];
+            edges.push_back(a < b ? (a << 32 | b) : (b << 32 | a));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i;
+        while (j < edges.size() && edges[j] == edges[i]) ++j;
+        if (j - i != 2) {
+            positionLocked[edges[i] >> 32] = true;
+            positionLocked[edges[i] & 0xffffffffu] = true;
+        }
+        i = j;
+    }
+    for (size_t v = 0; v < vertices.size(); ++v) locked[v] = positionLocked[positionId[v]];
+
+    // Area weighted plane quadrics, accumulated per position
+    std::vector<Quadric> quadrics(positionCount);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec3 &p0 = positions[indices[i]], &p1 = positions[indices[i + 1]], &p2 = positions[indices[i + 2]];
+        glm::vec3 n = triangleNormal(p0, p1, p2);
+        float area = glm::length(n);
+        if (area <= 0.0f) continue;
+        n = n / area;
+        double d = -glm::dot(n, p0);
+        for (size_t c = 0; c < 3; ++c) quadrics[positionId[indices[i + c]]].AddPlane(n, d, area * 0.5);
+    }
+
+    const double maxCost = double(maxError) * double(maxError);
+    double worstCost = 0.0;
+    std::vector<unsigned int> current = indices;
+    std::vector<unsigned int> offsets, adjacency, remap(vertices.size());
+    std::vector<Collapse> candidates;
+    std::vector<double> bestCost(vertices.size());
+    std::vector<unsigned int> bestTarget(vertices.size());
+    std::vector<bool> touched(vertices.size());
+
+    while (current.size() > targetIndexCount) {
+        const size_t triangleCount = current.size() / 3;
+
+        // Vertex to triangle adjacency of the current level
+        offsets.assign(vertices.size() + 1, 0);
+        for (unsigned int v: current) ++offsets[v + 1];
+        for (size_t v = 0; v < vertices.size(); ++v) offsets[v + 1] += offsets[v];
+        adjacency.resize(current.size());
+        {
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < current.size(); ++i) adjacency[fill[current[i]]++] = (unsigned int) (i / 3);
+        }
+
+        // Cheapest collapse per unlocked vertex: merging its quadric into a neighbour's position
+        std::fill(bestCost.begin(), bestCost.end(), -1.0);
+        for (size_t i = 0; i < current.size(); i += 3) {
+            for (size_t c = 0; c < 3; ++c) {
+                for (size_t o = 1; o < 3; ++o) {
+                    unsigned int from = current[i + c], to = current[i + (c + o) % 3];
+                    if (locked[from]) continue;
+                    Quadric q = quadrics[positionId[from]];
+                    q.Add(quadrics[positionId[to]]);
+                    double cost = q.Evaluate(positions[to]);
+                    if (bestCost[from] < 0.0 || cost < bestCost[from]) {
+                        bestCost[from] = cost;
+                        bestTarget[from] = to;
+                    }
+                }
+            }
+        }
+        candidates.clear();
+        for (unsigned int v = 0; v < vertices.size(); ++v)
+            if (bestCost[v] >= 0.0) candidates.push_back({v, bestTarget[v], bestCost[v]});
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse &a, const Collapse &b) { return a.cost < b.cost; });
+
+        // Apply independent collapses, cheapest first, until enough triangles are gone
+        const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+        size_t removed = 0;
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(touched.begin(), touched.end(), false);
+        for (const Collapse &collapse: candidates) {
+            if (removed >= trianglesToRemove || collapse.cost > maxCost) break;
+            if (touched[collapse.from] || touched[collapse.to]) continue;
+            const unsigned int target = positionId[collapse.to];
+            bool valid = true;
+            size_t collapsing = 0;
+            for (unsigned int a = offsets[collapse.from]; a < offsets[collapse.from + 1] && valid; ++a) {
+                const unsigned int *tri = &current[adjacency[a] * 3];
+                bool hasTarget = false;
+                for (size_t c = 0; c < 3; ++c) {
+                    if (positionId[tri[c]] != target) continue;
+                    // Another copy of the target position would be stretched across a seam
+                    if (tri[c] != collapse.to) valid = false;
+                    hasTarget = true;
+                }
+                if (hasTarget) {
+                    ++collapsing;
+                    continue;
+                }
+                glm::vec3 p[3], q[3];
+                for (size_t c = 0; c < 3; ++c) {
+                    p[c] = positions[tri[c]];
+                    q[c] = tri[c] == collapse.from ? positions[collapse.to] : p[c];
+                }
+                // Reject flips, and slivers whose normal swings towards the surface tangent
+                glm::vec3 before = triangleNormal(p[0], p[1], p[2]), after = triangleNormal(q[0], q[1], q[2]);
+                if (glm::dot(before, after) <= 0.25f * glm::length(before) * glm::length(after)) valid = false;
+            }
+            if (!valid) continue;
+
+            remap[collapse.from] = collapse.to;
+            for (unsigned int a = offsets[collapse.from]; a < offsets[collapse.from + 1]; ++a)
+                for (size_t c = 0; c < 3; ++c) touched[current[adjacency[a] * 3 + c]] = true;
+            quadrics[target].Add(quadrics[positionId[collapse.from]]);
+            worstCost = std::max(worstCost, collapse.cost);
+            removed += collapsing;
+        }
+        if (removed == 0) break;
+
+        // Rebuild the triangle list without the triangles that became degenerate
+        size_t write = 0;
+        for (size_t i = 0; i < current.size(); i += 3) {
+            unsigned int a = remap[current[i]], b = remap[current[i + 1]], c = remap[current[i + 2]];
+            unsigned int pa = positionId[a], pb = positionId[b], pc = positionId[c];
+            if (pa == pb || pb == pc || pa == pc) continue;
+            current[write++] = a;
+            current[write++] = b;
+            current[write++] = c;
+        }
+        current.resize(write);
+    }
+    outIndices.swap(current);
+    return (float) std::sqrt(worstCost);
+}
+
+void MeshSimplifier::BuildLodChain(const std::vector<Mesh::Vertex> &vertices, std::vector<unsigned int> &indices,
+                                   std::vector<Mesh::Lod> &outLods, const std::string &name) {
+    outLods.clear();
+    outLods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+    std::vector<unsigned int> source(indices);
+    std::vector<unsigned int> level;
+    float error = 0.0f;
+    std::string report = std::to_string(indices.size() / 3);
+    while (outLods.size() < Mesh::MAX_LODS) {
+        const size_t target = static_cast<size_t>(source.size() / 3 * LOD_TRIANGLE_RATIO) * 3;
+        float levelError = Simplify(vertices, source, target, LOD_MAX_ERROR, level);
+        if (level.empty() || (float) level.size() > (float) source.size() * (1.0f - LOD_MIN_REDUCTION)) break;
+        MeshOptimizer::OptimizeVertexCache(level, vertices.size());
+        // Each level simplifies the previous one, so the errors add up
+        error += levelError;
+        outLods.push_back({static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(level.size()), error});
+        indices.insert(indices.end(), level.begin(), level.end());
+        char buffer[48];
+        std::snprintf(buffer, sizeof(buffer), ", %zu (error %.4f)", level.size() / 3, error);
+        report += buffer;
+        source.swap(level);
+    }
+    Logger::Info("Generated " + std::to_string(outLods.size()) + " LODs for " + name + ": " + report + " triangles");
+}
@@ -0,0 +1,57 @@
+/**
+ * @file MeshSimplifier.h
+ * @brief Quadric error edge-collapse simplification and LOD chain generation.
+ * Simplified levels reuse the vertices of the full detail mesh, so all levels of a mesh
+ * share one vertex buffer and differ only in their index ranges.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MESHSIMPLIFIER_H
+#define BILLIARDSHOW_MESHSIMPLIFIER_H
+
+#pragma once
+
+#include "Mesh.h"
+
+#include <string>
+#include <vector>
+
+namespace MeshSimplifier {
+    // Fraction of the previous level's triangles each generated LOD aims for
+    constexpr float LOD_TRIANGLE_RATIO = 0.25f;
+
+    // A generated LOD is discarded unless it removes at least this fraction of the previous level's triangles
+    constexpr float LOD_MIN_REDUCTION = 0.2f;
+
+    // Largest geometric error a single simplification may introduce, relative to the bounding radius
+    constexpr float LOD_MAX_ERROR = 0.1f;
+
+    /**
+     * @brief Simplifies a triangle list by collapsing edges in order of increasing quadric error.
+     * Each collapse moves a vertex onto one of its neighbours (half-edge collapse), so no vertices
+     * are created. Vertices on texture seams, on open borders and at non-manifold edges are locked,
+     * and collapses that would flip a triangle are rejected.
+     * @param vertices The vertex buffer the indices refer to.
+     * @param indices Triangle list to simplify.
+     * @param targetIndexCount Stop once the result has at most this many indices.
+     * @param maxError Stop before a collapse whose error exceeds this, relative to the bounding radius.
+     * @param outIndices Receives the simplified triangle list.
+     * @return The largest error of the collapses performed, relative to the bounding radius.
+     */
+    float Simplify(const std::vector<Mesh::Vertex> &vertices, const std::vector<unsigned int> &indices,
+                   size_t targetIndexCount, float maxError, std::vector<unsigned int> &outIndices);
+
+    /**
+     * @brief Appends up to Mesh::MAX_LODS - 1 simplified levels to a triangle list.
+     * Each level simplifies the previous one and is reordered for the vertex cache.
+     * @param vertices The vertex buffer the indices refer to.
+     * @param indices The full detail triangle list; the generated levels are appended to it.
+     * @param outLods Receives the index ranges of all levels, full detail first.
+     * @param name Name used in the log report.
+     */
+    void BuildLodChain(const std::vector<Mesh::Vertex> &vertices, std::vector<unsigned int> &indices,
+                       std::vector<Mesh::Lod> &outLods, const std::string &name);
+}
+
+#endif //BILLIARDSHOW_MESHSIMPLIFIER_H
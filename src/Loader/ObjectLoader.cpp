@@ -8,6 +8,19 @@
     * @version 1.0
  */
 #include "ObjectLoader.h"
+#include "MeshCache.h"
+#include "MeshGenerator.h"
+#include "../Renderer/TextureUploader.h"
+#include "../Utils/AssetArchive.h"
+#include "../Utils/ThreadPool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
 
 struct Face {
     unsigned int v[3];
@@ -21,159 +34,799 @@ struct TempVertex {
     glm::vec2 tex;
 };
 
+/**
+ * @struct ObjCounts
+ * @brief Number of each record type found by the OBJ pre-scan.
+ * Used to reserve the parse arrays up front so they never reallocate.
+ */
+struct ObjCounts {
+    size_t positions = 0;
+    size_t normals = 0;
+    size_t texcoords = 0;
+    size_t faces = 0;
+};
+
+/**
+ * @fn isBlank
+ * @brief Checks whether a character is an in-line whitespace character.
+ */
+static inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @fn skipBlanks
+ * @brief Advances the cursor past spaces and tabs, stopping at the end of the line.
+ */
+static inline const char *skipBlanks(const char *p, const char *end) {
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+/**
+ * @fn prescanOBJ
+ * @brief Counts the vertex, normal, texcoord and face records of an OBJ buffer.
+ * Only the first two characters of each line are inspected, so this pass
+ * runs at close to memchr speed.
+ * @param p Start of the buffer.
+ * @param end One past the end of the buffer.
+ * @return The record counts.
+ */
+static ObjCounts prescanOBJ(const char *p, const char *end) {
+    ObjCounts counts;
+    while (p < end) {
+        p = skipBlanks(p, end);
+        if (end - p >= 2) {
+            if (p[0] == 'v') {
+                if (isBlank(p[1])) ++counts.positions;
+                else if (p[1] == 'n') ++counts.normals;
+                else if (p[1] == 't') ++counts.texcoords;
+            } else if (p[0] == 'f' && isBlank(p[1])) {
+                ++counts.faces;
+            }
+        }
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        p = eol ? eol + 1 : end;
+    }
+    return counts;
+}
+
+/**
+ * @fn parseFloats
+ * @brief Parses up to count whitespace separated floats in place with std::from_chars.
+ * Components missing from the line are left untouched.
+ * @return The cursor after the last parsed value.
+ */
+static const char *parseFloats(const char *p, const char *end, float *out, int count) {
+    for (int i = 0; i < count; ++i) {
+        p = skipBlanks(p, end);
+        if (p < end && *p == '+') ++p; // from_chars does not accept a leading plus sign
+        auto [next, ec] = std::from_chars(p, end, out[i]);
+        if (ec != std::errc()) break;
+        p = next;
+    }
+    return p;
+}
+
+/**
+ * @fn resolveIndex
+ * @brief Converts a 1-based (or negative, relative) OBJ index into a 0-based index.
+ * @param index The index as written in the file.
+ * @param count The number of elements defined so far.
+ * @return The 0-based index, or UINT_MAX if the index is zero.
+ */
+static inline unsigned int resolveIndex(long index, size_t count) {
+    if (index > 0) return static_cast<unsigned int>(index - 1);
+    if (index < 0) return static_cast<unsigned int>(static_cast<long>(count) + index);
+    return UINT_MAX;
+}
+
+/**
+ * @fn parseCorner
+ * @brief Parses one face corner in v, v/t, v//n or v/t/n form.
+ * Missing texcoord and normal indices are reported as UINT_MAX.
+ * @return The cursor after the corner, or nullptr if no corner could be parsed.
+ */
+static const char *parseCorner(const char *p, const char *end, const ObjCounts &defined,
+                               unsigned int &v, unsigned int &t, unsigned int &n) {
+    long value = 0;
+    auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc()) return nullptr;
+    v = resolveIndex(value, defined.positions);
+    t = UINT_MAX;
+    n = UINT_MAX;
+    p = next;
+    if (p < end && *p == '/') {
+        ++p;
+        if (p < end && *p != '/') {
+            auto [afterT, ecT] = std::from_chars(p, end, value);
+            if (ecT == std::errc()) {
+                t = resolveIndex(value, defined.texcoords);
+                p = afterT;
+            }
+        }
+        if (p < end && *p == '/') {
+            ++p;
+            auto [afterN, ecN] = std::from_chars(p, end, value);
+            if (ecN == std::errc()) {
+                n = resolveIndex(value, defined.normals);
+                p = afterN;
+            }
+        }
+    }
+    return p;
+}
+
+/**
+ * @struct VertexHash
+ * @brief Hashes the raw bytes of a vertex for welding identical face corners.
+ * FNV-1a over the 32-bit words of the position, normal and texcoord.
+ */
+struct VertexHash {
+    size_t operator()(const ObjectLoader::Vertex &v) const {
+        uint32_t words[8];
+        std::memcpy(words, &v, sizeof(words));
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t w: words) {
+            hash ^= w;
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+/**
+ * @struct VertexEqual
+ * @brief Compares two vertices bit for bit, matching VertexHash.
+ */
+struct VertexEqual {
+    bool operator()(const ObjectLoader::Vertex &a, const ObjectLoader::Vertex &b) const {
+        return std::memcmp(&a, &b, sizeof(ObjectLoader::Vertex)) == 0;
+    }
+};
+
+// Files below this size are parsed on the calling thread when the thread count is automatic
+static constexpr size_t PARALLEL_PARSE_MIN_BYTES = 4u << 20;
+// Smallest chunk handed to a parse thread, so tiny inputs are not split into useless pieces
+static constexpr size_t PARSE_CHUNK_MIN_BYTES = 256u << 10;
+
+/**
+ * @struct ObjChunk
+ * @brief A newline-aligned slice of OBJ text and what parsing it produced.
+ * The base counts are the records defined before the chunk, so relative face indices and the
+ * attribute arrays resolve against the whole file, exactly as a single pass would.
+ */
+struct ObjChunk {
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    ObjCounts counts;  // Records in this chunk, from the pre-scan
+    ObjCounts base;    // Records in all earlier chunks
+    std::vector<Face> faces;
+    size_t faceOffset = 0; // First face of this chunk in the merged face array
+    std::string mtlFile;   // Last mtllib statement in the chunk
+};
+
+/**
+ * @fn splitLines
+ * @brief Splits text into up to count chunks of similar size that each end after a newline.
+ */
+static std::vector<ObjChunk> splitLines(const char *data, size_t size, unsigned int count) {
+    std::vector<ObjChunk> chunks;
+    const char *end = data + size;
+    const char *p = data;
+    for (unsigned int i = 1; i <= count && p < end; ++i) {
+        const char *cut = i == count ? end : std::max(p, data + size / count * i);
+        if (cut < end) {
+            const char *eol = static_cast<const char *>(memchr(cut, '\n', end - cut));
+            cut = eol ? eol + 1 : end;
+        }
+        ObjChunk chunk;
+        chunk.begin = p;
+        chunk.end = cut;
+        chunks.push_back(std::move(chunk));
+        p = cut;
+    }
+    return chunks;
+}
+
+/**
+ * @fn parsePool
+ * @brief Gets the workers large OBJ files are parsed on, one per hardware thread.
+ * Started on first use and shared by every parse, so no parse pays for starting threads.
+ */
+static ThreadPool &parsePool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @fn parallelFor
+ * @brief Runs job(i) for every i in [0, count), on the pool if there is one, otherwise in order.
+ */
+template<typename Job>
+static void parallelFor(ThreadPool *pool, size_t count, const Job &job) {
+    if (!pool || count == 1) {
+        for (size_t i = 0; i < count; ++i) job(i);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) pool->Submit([&job, i]() { job(i); });
+    pool->Wait();
+}
+
+/**
+ * @fn parseChunk
+ * @brief Parses the records of one chunk.
+ * Attributes are written straight into the file-wide arrays at the chunk's base offsets, which the
+ * pre-scan sized exactly since it applies the same line tests; faces go into the chunk's own array because a face line can produce any
+ * number of triangles.
+ */
+static void parseChunk(ObjChunk &chunk, const std::string &path, glm::vec3 *positions, glm::vec3 *normals,
+                       glm::vec2 *texcoords) {
+    const char *p = chunk.begin;
+    const char *end = chunk.end;
+    chunk.faces.reserve(chunk.counts.faces);
+    ObjCounts defined = chunk.base;
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        const char *lineEnd = eol ? eol : end;
+        p = skipBlanks(p, lineEnd);
+        if (lineEnd - p >= 2) {
+            if (p[0] == 'v' && isBlank(p[1])) {
+                glm::vec3 &pos = positions[defined.positions++];
+                pos = glm::vec3(0.0f);
+                parseFloats(p + 2, lineEnd, &pos.x, 3);
+            } else if (p[0] == 'v' && p[1] == 'n') {
+                glm::vec3 &n = normals[defined.normals++];
+                n = glm::vec3(0.0f);
+                parseFloats(p + 2, lineEnd, &n.x, 3);
+            } else if (p[0] == 'v' && p[1] == 't') {
+                glm::vec2 &t = texcoords[defined.texcoords++];
+                t = glm::vec2(0.0f);
+                parseFloats(p + 2, lineEnd, &t.x, 2);
+            } else if (p[0] == 'f' && isBlank(p[1])) {
+                Face face = {};
+                int corners = 0;
+                const char *q = p + 2;
+                while (true) {
+                    q = skipBlanks(q, lineEnd);
+                    if (q >= lineEnd) break;
+                    unsigned int v, t, n;
+                    const char *next = parseCorner(q, lineEnd, defined, v, t, n);
+                    if (!next) break;
+                    q = next;
+                    // Fan triangulation: keep the first corner, shift the last one down
+                    int slot = corners < 3 ? corners : 2;
+                    if (corners >= 3) {
+                        chunk.faces.push_back(face);
+                        face.v[1] = face.v[2];
+                        face.t[1] = face.t[2];
+                        face.n[1] = face.n[2];
+                    }
+                    face.v[slot] = v;
+                    face.t[slot] = t;
+                    face.n[slot] = n;
+                    ++corners;
+                }
+                if (corners >= 3) {
+                    chunk.faces.push_back(face);
+                } else {
+                    Logger::Warn("Skipping degenerate face in OBJ file: " + path);
+                }
+            } else if (lineEnd - p > 7 && std::memcmp(p, "mtllib", 6) == 0 && isBlank(p[6])) {
+                const char *name = skipBlanks(p + 7, lineEnd);
+                const char *nameEnd = lineEnd;
+                while (nameEnd > name && isBlank(nameEnd[-1])) --nameEnd;
+                chunk.mtlFile.assign(name, nameEnd);
+            }
+        }
+        p = eol ? eol + 1 : end;
+    }
+}
+
+/**
+ * @struct ObjAttributes
+ * @brief The parsed attribute arrays that face corners index into.
+ */
+struct ObjAttributes {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> texcoords;
+
+    /**
+     * @brief Builds the vertex of one face corner; the position index must be valid.
+     */
+    ObjectLoader::Vertex Corner(const Face &face, int i) const {
+        ObjectLoader::Vertex v;
+        v.position = positions[face.v[i]];
+        v.normal = face.n[i] < normals.size() ? normals[face.n[i]] : glm::vec3(0, 0, 1);
+        v.texCoord = face.t[i] < texcoords.size() ? texcoords[face.t[i]] : glm::vec2(0, 0);
+        v.texCoord.y = 1.0f - v.texCoord.y; // Flip Y for OpenGL
+        return v;
+    }
+};
+
+/**
+ * @fn weldSerial
+ * @brief Welds identical face corners through one hash map, numbering vertices by first use.
+ */
+static void weldSerial(const ObjAttributes &attributes, const std::vector<Face> &faces,
+                       std::vector<ObjectLoader::Vertex> &outVertices, std::vector<unsigned int> &outIndices) {
+    // The unique vertex count is close to the position count
+    const size_t expected = attributes.positions.size() + attributes.positions.size() / 4;
+    std::unordered_map<ObjectLoader::Vertex, unsigned int, VertexHash, VertexEqual> unique;
+    unique.reserve(expected);
+    outVertices.reserve(expected);
+    outIndices.reserve(faces.size() * 3);
+    for (const auto &face: faces) {
+        for (int i = 0; i < 3; ++i) {
+            const ObjectLoader::Vertex v = attributes.Corner(face, i);
+            auto [it, inserted] = unique.try_emplace(v, (unsigned int) outVertices.size());
+            if (inserted) outVertices.push_back(v);
+            outIndices.push_back(it->second);
+        }
+    }
+}
+
+/**
+ * @fn weldParallel
+ * @brief Welds identical face corners on several threads with the same result as weldSerial.
+ * Corners are partitioned by hash, so equal vertices always meet in the same partition, and each
+ * partition finds the first corner of every vertex it owns. A prefix sum over the first corners
+ * then numbers the vertices in order of first use, exactly as the serial weld does.
+ */
+static void weldParallel(ThreadPool &pool, size_t rangeCount, const ObjAttributes &attributes,
+                         const std::vector<Face> &faces, std::vector<ObjectLoader::Vertex> &outVertices,
+                         std::vector<unsigned int> &outIndices) {
+    const size_t cornerCount = faces.size() * 3;
+    const size_t rangeSize = (cornerCount + rangeCount - 1) / rangeCount;
+    const auto rangeBegin = [&](size_t r) { return std::min(cornerCount, r * rangeSize); };
+
+    std::vector<size_t> hashes(cornerCount);
+    parallelFor(&pool, rangeCount, [&](size_t r) {
+        for (size_t c = rangeBegin(r); c < rangeBegin(r + 1); ++c)
+            hashes[c] = VertexHash()(attributes.Corner(faces[c / 3], (int) (c % 3)));
+    });
+
+    // Each partition owns the vertices whose hash selects it and records their first corner
+    std::vector<unsigned int> firstCorner(cornerCount);
+    parallelFor(&pool, rangeCount, [&](size_t partition) {
+        std::unordered_map<ObjectLoader::Vertex, unsigned int, VertexHash, VertexEqual> unique;
+        unique.reserve((attributes.positions.size() + attributes.positions.size() / 4) / rangeCount + 1);
+        for (size_t c = 0; c < cornerCount; ++c) {
+            if ((hashes[c] >> 40) % rangeCount != partition) continue;
+            auto it = unique.try_emplace(attributes.Corner(faces[c / 3], (int) (c % 3)), (unsigned int) c).first;
+            firstCorner[c] = it->second;
+        }
+    });
+
+    // Number the first corners in order: count per range, prefix sum, then assign
+    std::vector<size_t> rangeVertices(rangeCount + 1, 0);
+    parallelFor(&pool, rangeCount, [&](size_t r) {
+        for (size_t c = rangeBegin(r); c < rangeBegin(r + 1); ++c)
+            if (firstCorner[c] == c) ++rangeVertices[r + 1];
+    });
+    for (size_t r = 0; r < rangeCount; ++r) rangeVertices[r + 1] += rangeVertices[r];
+    std::vector<unsigned int> vertexOf(cornerCount);
+    outVertices.resize(rangeVertices[rangeCount]);
+    parallelFor(&pool, rangeCount, [&](size_t r) {
+        size_t next = rangeVertices[r];
+        for (size_t c = rangeBegin(r); c < rangeBegin(r + 1); ++c) {
+            if (firstCorner[c] != c) continue;
+            vertexOf[c] = (unsigned int) next;
+            outVertices[next++] = attributes.Corner(faces[c / 3], (int) (c % 3));
+        }
+    });
+    // A first corner never comes after its duplicates, but it may sit in an earlier range
+    outIndices.resize(cornerCount);
+    parallelFor(&pool, rangeCount, [&](size_t r) {
+        for (size_t c = rangeBegin(r); c < rangeBegin(r + 1); ++c) outIndices[c] = vertexOf[firstCorner[c]];
+    });
+}
+
+/**
+ * @fn parseOBJ
+ * @brief Parses OBJ text and extracts vertex data.
+ * The text is tokenized in place: lines are found with memchr and
+ * numbers are converted with std::from_chars, so no strings are allocated per line or token.
+ * A pre-scan counts the records first so every array is reserved exactly once.
+ * Polygons with more than three corners are triangulated as fans.
+ * Face corners with identical position/normal/texcoord values are welded into a single
+ * vertex through a hash map, and the triangles are emitted as an index list.
+ * Large files are split into newline-aligned chunks that are pre-scanned, parsed and welded on
+ * a thread pool shared by all parses. Prefix sums of the per-chunk record counts give each chunk the number of
+ * records defined before it, so indices, including relative ones, resolve exactly as in one pass
+ * and the output is identical to a single-threaded parse.
+ * @param data Start of the OBJ text, usually a memory mapped file.
+ * @param size Size of the OBJ text in bytes.
+ * @param path The path to the OBJ file, used in log messages.
+ * @param outVertices Output vector to store the unique vertices.
+ * @param outIndices Output vector to store three vertex indices per triangle.
+ * @param outMtlFile Output string to store the name of the material file if present.
+ * @param threadCount Number of chunks parsed at once; 0 uses one per hardware thread for files of a
+ * few megabytes or more, and the calling thread for smaller ones or when called from a pool worker.
+ * @return True if parsing was successful, false otherwise.
+ */
+bool parseOBJ(const char *data, size_t size, const std::string &path, std::vector<ObjectLoader::Vertex> &outVertices,
+              std::vector<unsigned int> &outIndices, std::string &outMtlFile, unsigned int threadCount) {
+    outMtlFile.clear();
+    outVertices.clear();
+    outIndices.clear();
+
+    // A caller that is itself a pool worker already runs alongside the other loads, so it parses alone
+    if (threadCount == 0)
+        threadCount = size >= PARALLEL_PARSE_MIN_BYTES && !ThreadPool::IsWorkerThread()
+                          ? ThreadPool::ResolveThreadCount(0)
+                          : 1;
+    threadCount = (unsigned int) std::clamp<size_t>(size / PARSE_CHUNK_MIN_BYTES, 1, threadCount);
+    ThreadPool *pool = threadCount > 1 ? &parsePool() : nullptr;
+
+    std::vector<ObjChunk> chunks = splitLines(data, size, threadCount);
+    parallelFor(pool, chunks.size(), [&](size_t i) {
+        chunks[i].counts = prescanOBJ(chunks[i].begin, chunks[i].end);
+    });
+    ObjCounts total;
+    for (auto &chunk: chunks) {
+        chunk.base = total;
+        total.positions += chunk.counts.positions;
+        total.normals += chunk.counts.normals;
+        total.texcoords += chunk.counts.texcoords;
+    }
+
+    ObjAttributes attributes;
+    attributes.positions.resize(total.positions);
+    attributes.normals.resize(total.normals);
+    attributes.texcoords.resize(total.texcoords);
+    parallelFor(pool, chunks.size(), [&](size_t i) {
+        parseChunk(chunks[i], path, attributes.positions.data(), attributes.normals.data(),
+                   attributes.texcoords.data());
+    });
+
+    // Merge the faces in file order and keep the last mtllib statement, as a single pass would
+    size_t faceCount = 0;
+    for (auto &chunk: chunks) {
+        chunk.faceOffset = faceCount;
+        faceCount += chunk.faces.size();
+        if (!chunk.mtlFile.empty()) outMtlFile = chunk.mtlFile;
+    }
+    std::vector<Face> faces;
+    if (chunks.size() == 1) {
+        faces = std::move(chunks[0].faces);
+    } else {
+        faces.resize(faceCount);
+        parallelFor(pool, chunks.size(), [&](size_t i) {
+            std::copy(chunks[i].faces.begin(), chunks[i].faces.end(), faces.begin() + (ptrdiff_t) chunks[i].faceOffset);
+            std::vector<Face>().swap(chunks[i].faces);
+        });
+    }
+
+    for (const auto &face: faces) {
+        if (face.v[0] >= total.positions || face.v[1] >= total.positions || face.v[2] >= total.positions) {
+            Logger::Error("Face references undefined vertex in OBJ file: " + path);
+            return false;
+        }
+    }
+
+    if (pool) weldParallel(*pool, threadCount, attributes, faces, outVertices, outIndices);
+    else weldSerial(attributes, faces, outVertices, outIndices);
+    return true;
+}
+
 /**
  * @fn parseOBJ
  * @brief Parses an OBJ file and extracts vertex data.
- * This function reads an OBJ file, extracts vertex positions, normals, and texture coordinates,
- * and constructs a list of vertices for rendering.
+ * Opens the file from the asset archive or maps it, and forwards to the in-memory parser.
  * @param path The path to the OBJ file.
- * @param outVertices Output vector to store the parsed vertices.
+ * @param outVertices Output vector to store the unique vertices.
+ * @param outIndices Output vector to store three vertex indices per triangle.
  * @param outMtlFile Output string to store the name of the material file if present.
  * @return True if parsing was successful, false otherwise.
  */
-bool parseOBJ(const std::string &path, std::vector<ObjectLoader::Vertex> &outVertices, std::string &outMtlFile) {
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec2> texcoords;
-    std::vector<Face> faces;
-    std::ifstream file(path);
-    if (!file.is_open()) {
+bool parseOBJ(const std::string &path, std::vector<ObjectLoader::Vertex> &outVertices,
+              std::vector<unsigned int> &outIndices, std::string &outMtlFile) {
+    AssetFile file;
+    if (!file.Open(path)) {
         Logger::Error("Failed to open OBJ file: " + path);
         return false;
     }
-    std::string line;
+    return parseOBJ(file.Data(), file.Size(), path, outVertices, outIndices, outMtlFile);
+}
+
+/**
+ * @fn parseOBJMaterial
+ * @brief Finds the mtllib statement of OBJ text without parsing any geometry.
+ * @param data Start of the OBJ text.
+ * @param size Size of the OBJ text in bytes.
+ * @param outMtlFile Output string to store the name of the material file, empty if none.
+ * @return True if an mtllib statement was found.
+ */
+bool parseOBJMaterial(const char *data, size_t size, std::string &outMtlFile) {
+    const char *p = data;
+    const char *end = data + size;
     outMtlFile.clear();
-    while (std::getline(file, line)) {
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        const char *lineEnd = eol ? eol : end;
+        p = skipBlanks(p, lineEnd);
+        if (lineEnd - p > 7 && std::memcmp(p, "mtllib", 6) == 0 && isBlank(p[6])) {
+            const char *name = skipBlanks(p + 7, lineEnd);
+            const char *nameEnd = lineEnd;
+            while (nameEnd > name && isBlank(nameEnd[-1])) --nameEnd;
+            outMtlFile.assign(name, nameEnd);
+            return true;
+        }
+        p = eol ? eol + 1 : end;
+    }
+    return false;
+}
+
+glm::mat4 ObjectLoader::viewProjection(1.0f);
+float ObjectLoader::projectionScaleY = 1.0f;
+float ObjectLoader::viewportHeight = 0.0f;
+std::vector<float> ObjectLoader::lodThresholds;
+
+/**
+ * @fn fileSize
+ * @brief Gets the size of an asset, or 0 if it does not exist.
+ */
+static uint64_t fileSize(const std::string &path) {
+    uint64_t size;
+    return AssetFile::Stat(path, size) ? size : 0;
+}
+
+/**
+ * @fn parseMTLDiffuseMap
+ * @brief Finds the map_Kd statement of MTL text.
+ * @param data Start of the MTL text.
+ * @param size Size of the MTL text in bytes.
+ * @param outTexFile Receives the texture file name, empty if none.
+ * @return True if a map_Kd statement was found.
+ */
+bool parseMTLDiffuseMap(const char *data, size_t size, std::string &outTexFile) {
+    outTexFile.clear();
+    std::istringstream text(std::string(data, size));
+    std::string line;
+    while (std::getline(text, line)) {
         std::istringstream iss(line);
         std::string type;
         iss >> type;
-        if (type == "mtllib") {
-            iss >> outMtlFile;
-        } else if (type == "v") {
-            glm::vec3 pos;
-            iss >> pos.x >> pos.y >> pos.z;
-            positions.push_back(pos);
-        } else if (type == "vn") {
-            glm::vec3 n;
-            iss >> n.x >> n.y >> n.z;
-            normals.push_back(n);
-        } else if (type == "vt") {
-            glm::vec2 t;
-            iss >> t.x >> t.y;
-            texcoords.push_back(t);
-        } else if (type == "f") {
-            Face face = {};
-            for (int i = 0; i < 3; ++i) {
-                std::string vert;
-                iss >> vert;
-                size_t p1 = vert.find('/');
-                size_t p2 = vert.find('/', p1 + 1);
-                face.v[i] = std::stoi(vert.substr(0, p1)) - 1;
-                if (p1 != std::string::npos && p2 != std::string::npos && p2 > p1 + 1)
-                    face.t[i] = std::stoi(vert.substr(p1 + 1, p2 - p1 - 1)) - 1;
-                else
-                    face.t[i] = 0;
-                if (p2 != std::string::npos)
-                    face.n[i] = std::stoi(vert.substr(p2 + 1)) - 1;
-                else
-                    face.n[i] = 0;
-            }
-            faces.push_back(face);
-        }
-    }
-    outVertices.clear();
-    for (const auto &face: faces) {
-        for (int i = 0; i < 3; ++i) {
-            ObjectLoader::Vertex v;
-            v.position = positions[face.v[i]];
-            v.normal = normals.empty() ? glm::vec3(0, 0, 1) : normals[face.n[i]];
-            v.texCoord = texcoords.empty() ? glm::vec2(0, 0) : texcoords[face.t[i]];
-            v.texCoord.y = 1.0f - v.texCoord.y; // Flip Y for OpenGL
-            outVertices.push_back(v);
+        if (type == "map_Kd") {
+            iss >> outTexFile;
+            return true;
         }
     }
+    return false;
+}
+
+/**
+ * @fn readDiffuseMap
+ * @brief Finds the map_Kd texture named by an MTL file.
+ * @param mtlPath The path to the MTL file.
+ * @param outTexFile Receives the texture file name, relative to the MTL file.
+ * @return False if the MTL file could not be opened.
+ */
+static bool readDiffuseMap(const std::string &mtlPath, std::string &outTexFile) {
+    outTexFile.clear();
+    AssetFile mtl;
+    if (!mtl.Open(mtlPath)) return false;
+    parseMTLDiffuseMap(mtl.Data(), mtl.Size(), outTexFile);
     return true;
 }
 
+/**
+ * @fn ListAssets
+ * @brief Collects the files Load() reads for a model: the OBJ, its MTL and the MTL's texture.
+ * Only the OBJ header up to its mtllib statement and the small MTL file are read.
+ * @param obj_model_filepath The path to the OBJ model file.
+ * @param outPaths Receives the paths, whether or not the files exist.
+ */
+void ObjectLoader::ListAssets(const std::string &obj_model_filepath, std::vector<std::string> &outPaths) {
+    outPaths.push_back(obj_model_filepath);
+    AssetFile file;
+    std::string mtlFile;
+    if (!file.Open(obj_model_filepath) || !parseOBJMaterial(file.Data(), file.Size(), mtlFile)) return;
+    std::string dir = obj_model_filepath.substr(0, obj_model_filepath.find_last_of("/\\") + 1);
+    ListMaterialAssets(dir + mtlFile, outPaths);
+}
+
+/**
+ * @fn ListMaterialAssets
+ * @brief Collects an MTL file and the texture it names.
+ * @param mtl_filepath The path to the MTL file.
+ * @param outPaths Receives the paths, whether or not the files exist.
+ */
+void ObjectLoader::ListMaterialAssets(const std::string &mtl_filepath, std::vector<std::string> &outPaths) {
+    outPaths.push_back(mtl_filepath);
+    std::string dir = mtl_filepath.substr(0, mtl_filepath.find_last_of("/\\") + 1);
+    std::string texFile;
+    if (readDiffuseMap(mtl_filepath, texFile) && !texFile.empty()) outPaths.push_back(dir + texFile);
+}
+
+/**
+ * @fn ListReferencedAssets
+ * @brief Collects the file an OBJ or MTL file names: the OBJ's MTL, or the MTL's texture.
+ * Works on contents already in memory, so a prefetcher can queue the next file as soon as one arrives.
+ * @param path The path to the file; its extension tells what kind of file it is.
+ * @param data Start of the file contents.
+ * @param size Size of the file contents in bytes.
+ * @param outPaths Receives the paths, whether or not the files exist.
+ */
+void ObjectLoader::ListReferencedAssets(const std::string &path, const char *data, size_t size,
+                                        std::vector<std::string> &outPaths) {
+    std::string name;
+    if (path.ends_with(".obj")) parseOBJMaterial(data, size, name);
+    else if (path.ends_with(".mtl")) parseMTLDiffuseMap(data, size, name);
+    if (!name.empty()) outPaths.push_back(path.substr(0, path.find_last_of("/\\") + 1) + name);
+}
+
+/**
+ * @fn MeasureAssets
+ * @brief Sums the sizes of the files Load() processes for a model.
+ * @param obj_model_filepath The path to the OBJ model file.
+ * @return The size in bytes of the OBJ, MTL and texture files that exist.
+ */
+uint64_t ObjectLoader::MeasureAssets(const std::string &obj_model_filepath) {
+    std::vector<std::string> paths;
+    ListAssets(obj_model_filepath, paths);
+    uint64_t bytes = 0;
+    for (const auto &path: paths) bytes += fileSize(path);
+    return bytes;
+}
+
+/**
+ * @fn MeasureMaterial
+ * @brief Sums the sizes of an MTL file and the texture it names.
+ * @param mtl_filepath The path to the MTL file.
+ * @return The size in bytes of the MTL and texture files that exist.
+ */
+uint64_t ObjectLoader::MeasureMaterial(const std::string &mtl_filepath) {
+    std::vector<std::string> paths;
+    ListMaterialAssets(mtl_filepath, paths);
+    uint64_t bytes = 0;
+    for (const auto &path: paths) bytes += fileSize(path);
+    return bytes;
+}
+
 /**
  * @brief Constructor for ObjectLoader.
- * Initializes the ObjectLoader with empty vertex data and OpenGL buffers.
+ * Initializes the ObjectLoader without a mesh or texture.
  */
 ObjectLoader::ObjectLoader() {}
 
 /**
  * @brief Destructor for ObjectLoader.
- * Cleans up OpenGL buffers if they were created.
+ * The shared mesh is released when its last owner goes away.
  */
-ObjectLoader::~ObjectLoader() {
-    if (VBO) glDeleteBuffers(1, &VBO);
-    if (VAO) glDeleteVertexArrays(1, &VAO);
-}
+ObjectLoader::~ObjectLoader() {}
 
 /**
  * @fn Load
  * @brief Loads an OBJ model from a file.
- * This function reads an OBJ file, extracts vertex data, and attempts to load a texture from the associated MTL file if present.
+ * The geometry comes from the process-wide MeshCache, so files with identical geometry share one mesh.
+ * The texture named by the associated MTL file, if present, is decoded into staging memory and
+ * owned by this loader. No OpenGL calls are made, so Load() may run on a worker thread.
+ * The stop token is checked between stages and while the texture streams into the decoder.
  * @param obj_model_filepath The path to the OBJ model file.
- * @return True if the model was loaded successfully, false otherwise.
+ * @param stop Token that cancels the load.
+ * @param progress Advanced by the bytes of each file as it is processed, matching MeasureAssets().
+ * @return True if the model was loaded successfully, false otherwise or if cancelled.
  */
-bool ObjectLoader::Load(const std::string &obj_model_filepath) {
+bool ObjectLoader::Load(const std::string &obj_model_filepath, std::stop_token stop, LoadProgress *progress) {
     std::string mtlFile;
-    bool ok = parseOBJ(obj_model_filepath, vertices, mtlFile);
-    if (!ok) {
+    sourcePath = obj_model_filepath;
+    if (stop.stop_requested()) return false;
+    mesh = MeshCache::Instance().Acquire(obj_model_filepath, mtlFile);
+    if (!mesh) {
         Logger::Error("Failed to parse OBJ file: " + obj_model_filepath);
         return false;
     }
+    Logger::Info("Loaded " + obj_model_filepath + ": " + std::to_string(mesh->GetVertexCount()) + " vertices, " +
+                 std::to_string(mesh->GetLod(0).indexCount / 3) + " triangles, " +
+                 std::to_string(mesh->GetLodCount()) + " LODs");
+    if (progress) progress->Advance(fileSize(obj_model_filepath));
     // Try to load texture from .mtl if present
     if (!mtlFile.empty()) {
         // Find the directory of an obj file
         std::string dir = obj_model_filepath.substr(0, obj_model_filepath.find_last_of("/\\") + 1);
-        std::ifstream mtl(dir + mtlFile);
-        if (mtl.is_open()) {
-            Logger::Info("Loaded MTL file: " + dir + mtlFile);
-            std::string line;
-            while (std::getline(mtl, line)) {
-                std::istringstream iss(line);
-                std::string type;
-                iss >> type;
-                if (type == "map_Kd") {
-                    std::string texFile;
-                    iss >> texFile;
-                    SetTexture(dir + texFile);
-                    break;
-                }
-            }
-        } else if (!mtlFile.empty()) {
-            Logger::Warn("Could not open MTL file: " + dir + mtlFile);
-        }
+        if (!LoadMaterial(dir + mtlFile, stop, progress)) return false;
+    }
+    return !stop.stop_requested();
+}
+
+/**
+ * @fn LoadSphere
+ * @brief Loads a procedural sphere model.
+ * The geometry is the process-wide shared UV sphere of the given tessellation (see MeshGenerator),
+ * so no geometry file is opened; only the MTL file and its texture are read.
+ * @param segments Segments around the sphere's axis of the full detail level.
+ * @param mtl_filepath The path to the MTL file naming the texture.
+ * @param stop Token that cancels the load.
+ * @param progress Advanced by the bytes of each file as it is processed, matching MeasureMaterial().
+ * @return True if the model was loaded successfully, false otherwise or if cancelled.
+ */
+bool ObjectLoader::LoadSphere(int segments, const std::string &mtl_filepath, std::stop_token stop,
+                              LoadProgress *progress) {
+    sourcePath = mtl_filepath;
+    if (stop.stop_requested()) return false;
+    mesh = MeshCache::Instance().AcquireSphere(segments);
+    if (!mesh) {
+        Logger::Error("Failed to generate sphere with " + std::to_string(segments) + " segments");
+        return false;
+    }
+    if (!LoadMaterial(mtl_filepath, stop, progress)) return false;
+    return !stop.stop_requested();
+}
+
+/**
+ * @fn LoadMaterial
+ * @brief Decodes the texture named by the map_Kd statement of an MTL file.
+ * A missing MTL file or a texture that fails to decode is logged and leaves the model untextured.
+ * @return False only if the load was stopped.
+ */
+bool ObjectLoader::LoadMaterial(const std::string &mtl_filepath, std::stop_token stop, LoadProgress *progress) {
+    if (stop.stop_requested()) return false;
+    std::string dir = mtl_filepath.substr(0, mtl_filepath.find_last_of("/\\") + 1);
+    std::string texFile;
+    if (!readDiffuseMap(mtl_filepath, texFile)) {
+        Logger::Warn("Could not open MTL file: " + mtl_filepath);
+        return true;
+    }
+    Logger::Info("Loaded MTL file: " + mtl_filepath);
+    if (progress) progress->Advance(fileSize(mtl_filepath));
+    // Decode only; the GL upload happens in Install() on the main thread
+    if (!texFile.empty() && !texture.Decode(dir + texFile, stop, progress)) {
+        if (stop.stop_requested()) return false;
+        Logger::Error("Failed to decode texture: " + dir + texFile);
     }
     return true;
 }
 
 /**
  * @fn Install
- * @brief Sets up OpenGL buffers for rendering the loaded model.
- * This function creates a Vertex Array Object (VAO) and Vertex Buffer Object (VBO),
- * uploads the vertex data to the GPU, and configures the vertex attributes.
- * @return True if the installation was successful, false otherwise.
+ * @brief Uploads the shared mesh to the GPU and queues the decoded texture for streaming.
+ * The first ObjectLoader to install a shared mesh uploads it; later calls only queue the texture.
+ * The texture is streamed by the TextureUploader over the following frames and the model
+ * renders untextured until it arrives.
+ * Must be called on the thread that owns the OpenGL context.
+ * @return True if the mesh is installed, false otherwise.
  */
 bool ObjectLoader::Install() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ObjectLoader::Vertex), vertices.data(), GL_STATIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ObjectLoader::Vertex), (void *) 0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ObjectLoader::Vertex),
-                          (void *) offsetof(ObjectLoader::Vertex, normal));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ObjectLoader::Vertex),
-                          (void *) offsetof(ObjectLoader::Vertex, texCoord));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    return true;
+    if (!mesh) {
+        Logger::Error("ObjectLoader::Install called before a mesh was loaded");
+        return false;
+    }
+    if (textureArray) {
+        // Only the model that fills the layer uploads; the others share it and drop their copy
+        bool upload = uploadsTextureLayer && texture.HasPendingUpload();
+        if (upload && texture.GetFormat() != textureArray->GetFormat()) {
+            Logger::Warn("Texture format does not match the texture array, its layer stays empty: " +
+                         texture.GetSourcePath());
+            upload = false;
+        } else if (upload && (texture.GetWidth() != textureArray->GetWidth() ||
+                              texture.GetHeight() != textureArray->GetHeight())) {
+            Logger::Warn("Texture was not resized to the texture array, its layer stays empty: " +
+                         texture.GetSourcePath());
+            upload = false;
+        }
+        if (upload) TextureUploader::Instance().EnqueueLayer(&texture, textureArray, textureLayer);
+        else texture.FreeStaging();
+    } else if (texture.HasPendingUpload()) {
+        TextureUploader::Instance().Enqueue(&texture);
+    }
+    return mesh->Install();
+}
+
+/**
+ * @fn SetTextureLayer
+ * @brief Makes the model sample its texture from a layer of a shared texture array.
+ * Must be called before Install().
+ * @param array The shared array, already allocated.
+ * @param layer The layer holding this model's texture.
+ * @param uploadLayer True if this model's decoded image should fill the layer.
+ */
+void ObjectLoader::SetTextureLayer(TextureArray *array, int layer, bool uploadLayer) {
+    textureArray = array;
+    textureLayer = layer;
+    uploadsTextureLayer = uploadLayer;
 }
 
 /**
@@ -224,14 +877,58 @@ void ObjectLoader::Render(const glm::vec3 &position, float scale, const glm::mat
     model = model * rotation;
     model = glm::scale(model, glm::vec3(scale));
     shader->setMat4("model", model);
-    if (texture.IsValid()) {
+    if (textureArray) {
+        // The array is bound once by the caller; only the layer changes per draw (-1 until it has arrived)
+        shader->setInt("textureLayer", textureArray->IsLayerReady(textureLayer) ? textureLayer : -1);
+    } else if (texture.IsValid()) {
         shader->setBool("useTexture", true);
         texture.Bind();
     } else {
         shader->setBool("useTexture", false);
     }
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, (GLsizei) vertices.size());
-    glBindVertexArray(0);
+    if (mesh) mesh->Draw(SelectLod(model, scale));
+}
+
+/**
+ * @fn SetViewContext
+ * @brief Sets the camera and viewport used to pick levels of detail.
+ * Must be called whenever the view or projection changes, before the models are rendered.
+ * @param view The view matrix.
+ * @param projection The projection matrix, perspective or orthographic.
+ * @param viewportHeight The height of the viewport in pixels.
+ */
+void ObjectLoader::SetViewContext(const glm::mat4 &view, const glm::mat4 &projection, float viewportHeight) {
+    ObjectLoader::viewProjection = projection * view;
+    ObjectLoader::projectionScaleY = projection[1][1];
+    ObjectLoader::viewportHeight = viewportHeight;
+}
+
+/**
+ * @fn SetLodThresholds
+ * @brief Sets the LOD transition thresholds.
+ * A model whose projected radius is below screenRadii[i] pixels draws LOD i + 1 or coarser.
+ * @param screenRadii Radii in pixels, in decreasing order.
+ */
+void ObjectLoader::SetLodThresholds(const std::vector<float> &screenRadii) {
+    lodThresholds = screenRadii;
+}
+
+/**
+ * @fn SelectLod
+ * @brief Picks a level of detail from the projected screen-space radius of the mesh's bounding sphere.
+ * The radius is scaled by projection[1][1] / w, which is correct for perspective (w = view depth)
+ * and orthographic (w = 1) projections alike.
+ * @param model The model matrix of the instance.
+ * @param scale The uniform scale contained in the model matrix.
+ * @return The LOD index, 0 being full detail.
+ */
+size_t ObjectLoader::SelectLod(const glm::mat4 &model, float scale) const {
+    if (!mesh || mesh->GetLodCount() < 2 || viewportHeight <= 0.0f) return 0;
+    glm::vec4 clip = viewProjection * model * glm::vec4(mesh->GetBoundsCenter(), 1.0f);
+    if (clip.w <= 1e-4f) return 0; // At or behind the eye; let clipping deal with it
+    const float radius = mesh->GetBoundingRadius() * scale * projectionScaleY / clip.w * viewportHeight * 0.5f;
+    size_t lod = 0;
+    while (lod < lodThresholds.size() && radius < lodThresholds[lod]) ++lod;
+    return std::min(lod, mesh->GetLodCount() - 1);
 }
 
@@ -7,9 +7,12 @@
 #include <GL/glew.h>
 #include <glm/ext/matrix_transform.hpp>
 
+#include "Mesh.h"
 #include "../Renderer/Texture.h"
+#include "../Renderer/TextureArray.h"
 #include "../Utils/Logger.h"
 #include "../Renderer/Shader.h"
+#include "../Utils/LoadProgress.h"
 
 #include <fstream>
 #include <sstream>
@@ -17,6 +20,8 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <memory>
+#include <stop_token>
 
 class ObjectLoader {
 public:
@@ -24,10 +29,32 @@ public:
 
     ~ObjectLoader();
 
-    // Loads vertices/normals/texcoords from the .obj file
-    bool Load(const std::string &obj_model_filepath);
+    // Loads vertices/normals/texcoords from the .obj file and decodes its texture (no OpenGL calls).
+    // Returns false without finishing if stop is requested; progress advances by the bytes processed.
+    bool Load(const std::string &obj_model_filepath, std::stop_token stop = {}, LoadProgress *progress = nullptr);
 
-    // Sends vertex data to GPU (VAO/VBO)
+    // Returns the number of bytes Load processes for a model: the .obj, its .mtl and its texture
+    static uint64_t MeasureAssets(const std::string &obj_model_filepath);
+
+    // Uses a shared procedural UV sphere with the given segments instead of OBJ geometry, and decodes
+    // the texture named by the .mtl file. No geometry is read; otherwise behaves like Load.
+    bool LoadSphere(int segments, const std::string &mtl_filepath, std::stop_token stop = {},
+                    LoadProgress *progress = nullptr);
+
+    // Returns the number of bytes LoadSphere processes: the .mtl and its texture
+    static uint64_t MeasureMaterial(const std::string &mtl_filepath);
+
+    // Appends the files Load reads for an OBJ model (the .obj, its .mtl and the texture) to outPaths
+    static void ListAssets(const std::string &obj_model_filepath, std::vector<std::string> &outPaths);
+
+    // Appends the files LoadSphere reads (the .mtl and its texture) to outPaths
+    static void ListMaterialAssets(const std::string &mtl_filepath, std::vector<std::string> &outPaths);
+
+    // Appends the file named by in-memory .obj (its .mtl) or .mtl (its texture) contents to outPaths
+    static void ListReferencedAssets(const std::string &path, const char *data, size_t size,
+                                     std::vector<std::string> &outPaths);
+
+    // Sends the shared mesh (unless another loader already did) and the texture to GPU
     bool Install();
 
     // Renders the model at position (ignore orientation for now)
@@ -38,16 +65,64 @@ public:
 
     void SetTexture(const std::string &path);
 
-    struct Vertex {
-        glm::vec3 position;
-        glm::vec3 normal;
-        glm::vec2 texCoord;
-    };
+    // Makes the model sample its texture from a layer of a shared texture array instead of its own texture.
+    // If uploadLayer is set, Install() streams the decoded image into that layer, which it must already
+    // fit (see ResampleTexture); otherwise another model provides the layer and the decoded image is dropped.
+    void SetTextureLayer(TextureArray *array, int layer, bool uploadLayer);
+
+    // Resizes the decoded texture, e.g. to the layer size of a texture array (no OpenGL calls)
+    bool ResampleTexture(int width, int height) { return texture.Resample(width, height); }
+
+    const Texture &GetTexture() const { return texture; }
+
+    // Replaces the geometry with an installed mesh, e.g. after its file was reloaded
+    void SetMesh(std::shared_ptr<Mesh> newMesh) { mesh = std::move(newMesh); }
+
+    // Returns the OBJ file the model was loaded from (the .mtl for a procedural sphere)
+    const std::string &GetSourcePath() const { return sourcePath; }
+
+    // Sets the camera and viewport that Render uses to pick levels of detail (call once per view)
+    static void SetViewContext(const glm::mat4 &view, const glm::mat4 &projection, float viewportHeight);
+
+    // Sets the projected radii in pixels below which each coarser LOD is drawn, finest transition first
+    static void SetLodThresholds(const std::vector<float> &screenRadii);
+
+    // Picks the level of detail for a model placed at position from its projected screen-space radius
+    size_t SelectLod(const glm::mat4 &model, float scale) const;
+
+    using Vertex = Mesh::Vertex;
 
 private:
-    std::vector<Vertex> vertices;
-    unsigned int VAO = 0, VBO = 0;
+    // Decodes the texture named by a .mtl file; false only if stopped
+    bool LoadMaterial(const std::string &mtl_filepath, std::stop_token stop, LoadProgress *progress);
+
+    static glm::mat4 viewProjection;
+    static float projectionScaleY; // projection[1][1], converts view-space size to clip space
+    static float viewportHeight;   // 0 until a view context is set, which selects full detail
+    static std::vector<float> lodThresholds; // Empty until configured, which selects full detail
+
+    std::string sourcePath; // OBJ file this loader was loaded from (the .mtl for a procedural sphere)
+    std::shared_ptr<Mesh> mesh; // Shared with every loader that has the same geometry
     Texture texture;
+    TextureArray *textureArray = nullptr; // Shared array the texture lives in, if any
+    int textureLayer = -1;
+    bool uploadsTextureLayer = false;
 };
 
+// Parses in-memory OBJ text into welded vertices and triangle indices; large files are split across
+// threadCount threads of a shared parse pool (0 = one per hardware thread for large files, the calling
+// thread for small ones or when called from a ThreadPool worker)
+bool parseOBJ(const char *data, size_t size, const std::string &path, std::vector<ObjectLoader::Vertex> &outVertices,
+              std::vector<unsigned int> &outIndices, std::string &outMtlFile, unsigned int threadCount = 0);
+
+// Memory maps and parses an OBJ file into welded vertices and triangle indices
+bool parseOBJ(const std::string &path, std::vector<ObjectLoader::Vertex> &outVertices,
+              std::vector<unsigned int> &outIndices, std::string &outMtlFile);
+
+// Finds the mtllib statement of in-memory OBJ text without parsing the geometry
+bool parseOBJMaterial(const char *data, size_t size, std::string &outMtlFile);
+
+// Finds the map_Kd statement of in-memory MTL text
+bool parseMTLDiffuseMap(const char *data, size_t size, std::string &outTexFile);
+
 #endif //BILLIARDSHOW_OBJECTLOADER_H
@@ -0,0 +1,235 @@
+/**
+ * @file BC1Encoder.cpp
+ * @brief Implementation of the BC1 block encoder.
+ * The bounding box and the per-pixel projections run in SSE2 registers; endpoint selection and
+ * quantization are scalar, since they only touch a handful of values per block.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "BC1Encoder.h"
+#include "MipChain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define BC1_SSE2 1
+#include <emmintrin.h>
+#endif
+
+size_t BC1Encoder::ImageBytes(int width, int height) {
+    return (size_t) ((width + 3) / 4) * (size_t) ((height + 3) / 4) * BLOCK_BYTES;
+}
+
+size_t BC1Encoder::LevelOffset(int width, int height, int level) {
+    size_t offset = 0;
+    for (int i = 0; i < level; ++i)
+        offset += ImageBytes(MipChain::LevelSize(width, i), MipChain::LevelSize(height, i));
+    return offset;
+}
+
+/**
+ * @brief Computes the per-channel minimum and maximum of a block's 16 pixels.
+ */
+static void boundingBox(const unsigned char *rgba, unsigned char mn[4], unsigned char mx[4]) {
+#ifdef BC1_SSE2
+    __m128i lo = _mm_loadu_si128((const __m128i *) rgba);
+    __m128i hi = lo;
+    for (int row = 1; row < 4; ++row) {
+        __m128i r = _mm_loadu_si128((const __m128i *) (rgba + row * 16));
+        lo = _mm_min_epu8(lo, r);
+        hi = _mm_max_epu8(hi, r);
+    }
+    // Fold the four pixels of each register into one
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t packedMin = (uint32_t) _mm_cvtsi128_si32(lo);
+    uint32_t packedMax = (uint32_t) _mm_cvtsi128_si32(hi);
+    std::memcpy(mn, &packedMin, 4);
+    std::memcpy(mx, &packedMax, 4);
+#else
+    for (int c = 0; c < 4; ++c) mn[c] = 255, mx[c] = 0;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            mn[c] = std::min(mn[c], rgba[i * 4 + c]);
+            mx[c] = std::max(mx[c], rgba[i * 4 + c]);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Projects the 16 pixels onto the line from e0 to e0 + d and rounds to the nearest of
+ * the four palette positions (0 = e0, 3 = e0 + d).
+ */
+static void projectPixels(const unsigned char *rgba, const int e0[3], const int d[3], float scale,
+                          unsigned char steps[16]) {
+#ifdef BC1_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i origin = _mm_setr_epi16((short) e0[0], (short) e0[1], (short) e0[2], 0,
+                                          (short) e0[0], (short) e0[1], (short) e0[2], 0);
+    const __m128i axis = _mm_setr_epi16((short) d[0], (short) d[1], (short) d[2], 0,
+                                        (short) d[0], (short) d[1], (short) d[2], 0);
+    const __m128 factor = _mm_set1_ps(scale);
+    __m128i rows[4];
+    for (int row = 0; row < 4; ++row) {
+        __m128i px = _mm_loadu_si128((const __m128i *) (rgba + row * 16));
+        // Two pixels per register: madd gives r*dr + g*dg and b*db per pixel, the shuffle adds them
+        __m128i lo = _mm_madd_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(px, zero), origin), axis);
+        __m128i hi = _mm_madd_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(px, zero), origin), axis);
+        lo = _mm_add_epi32(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+        hi = _mm_add_epi32(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128i dots = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi),
+                                                       _MM_SHUFFLE(2, 0, 2, 0)));
+        rows[row] = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(dots), factor));
+    }
+    __m128i s01 = _mm_packs_epi32(rows[0], rows[1]);
+    __m128i s23 = _mm_packs_epi32(rows[2], rows[3]);
+    const __m128i three = _mm_set1_epi16(3);
+    s01 = _mm_min_epi16(_mm_max_epi16(s01, zero), three);
+    s23 = _mm_min_epi16(_mm_max_epi16(s23, zero), three);
+    _mm_storeu_si128((__m128i *) steps, _mm_packus_epi16(s01, s23));
+#else
+    for (int i = 0; i < 16; ++i) {
+        const unsigned char *p = rgba + i * 4;
+        int dot = (p[0] - e0[0]) * d[0] + (p[1] - e0[1]) * d[1] + (p[2] - e0[2]) * d[2];
+        int step = (int) std::nearbyint((float) dot * scale);
+        steps[i] = (unsigned char) std::clamp(step, 0, 3);
+    }
+#endif
+}
+
+static uint16_t toRGB565(const int c[3]) {
+    int r = (c[0] * 31 + 127) / 255;
+    int g = (c[1] * 63 + 127) / 255;
+    int b = (c[2] * 31 + 127) / 255;
+    return (uint16_t) ((r << 11) | (g << 5) | b);
+}
+
+static void fromRGB565(uint16_t v, int c[3]) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+void BC1Encoder::CompressBlock(const unsigned char *rgba, unsigned char *out) {
+    unsigned char mn[4], mx[4];
+    boundingBox(rgba, mn, mx);
+
+    // Pull the box in by 1/16 of its size, which lowers the error for the interior colours
+    int lo[3], hi[3];
+    for (int c = 0; c < 3; ++c) {
+        int inset = (mx[c] - mn[c]) >> 4;
+        lo[c] = mn[c] + inset;
+        hi[c] = mx[c] - inset;
+    }
+
+    // The box has four diagonals; follow the colour distribution by flipping every channel that
+    // correlates negatively with the channel of the largest range
+    int axis = 0;
+    for (int c = 1; c < 3; ++c)
+        if (mx[c] - mn[c] > mx[axis] - mn[axis]) axis = c;
+    int centre[3], covariance[3] = {0, 0, 0};
+    for (int c = 0; c < 3; ++c) centre[c] = (mn[c] + mx[c] + 1) >> 1;
+    for (int i = 0; i < 16; ++i) {
+        int da = rgba[i * 4 + axis] - centre[axis];
+        for (int c = 0; c < 3; ++c) covariance[c] += (rgba[i * 4 + c] - centre[c]) * da;
+    }
+    for (int c = 0; c < 3; ++c)
+        if (covariance[c] < 0) std::swap(lo[c], hi[c]);
+
+    uint16_t color0 = toRGB565(hi);
+    uint16_t color1 = toRGB565(lo);
+    // color0 > color1 selects the four colour palette; equal endpoints leave all indices at 0
+    if (color0 < color1) std::swap(color0, color1);
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int e0[3], e1[3], d[3];
+        fromRGB565(color0, e0);
+        fromRGB565(color1, e1);
+        int lengthSquared = 0;
+        for (int c = 0; c < 3; ++c) {
+            d[c] = e1[c] - e0[c];
+            lengthSquared += d[c] * d[c];
+        }
+        unsigned char steps[16];
+        projectPixels(rgba, e0, d, 3.0f / (float) lengthSquared, steps);
+        // Palette order is color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1
+        static constexpr uint32_t STEP_TO_INDEX[4] = {0, 2, 3, 1};
+        for (int i = 0; i < 16; ++i) indices |= STEP_TO_INDEX[steps[i]] << (2 * i);
+    }
+    out[0] = (unsigned char) (color0 & 0xFF);
+    out[1] = (unsigned char) (color0 >> 8);
+    out[2] = (unsigned char) (color1 & 0xFF);
+    out[3] = (unsigned char) (color1 >> 8);
+    for (int i = 0; i < 4; ++i) out[4 + i] = (unsigned char) (indices >> (8 * i));
+}
+
+void BC1Encoder::CompressImage(const unsigned char *rgba, int width, int height, unsigned char *out) {
+    unsigned char block[64];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            if (bx + 4 <= width && by + 4 <= height) {
+                for (int row = 0; row < 4; ++row)
+                    std::memcpy(block + row * 16, rgba + ((size_t) (by + row) * width + bx) * 4, 16);
+            } else {
+                for (int row = 0; row < 4; ++row) {
+                    int y = std::min(by + row, height - 1);
+                    for (int col = 0; col < 4; ++col) {
+                        int x = std::min(bx + col, width - 1);
+                        std::memcpy(block + row * 16 + col * 4, rgba + ((size_t) y * width + x) * 4, 4);
+                    }
+                }
+            }
+            CompressBlock(block, out);
+            out += BLOCK_BYTES;
+        }
+    }
+}
+
+void BC1Encoder::CompressChain(const unsigned char *chain, int width, int height, unsigned char *out) {
+    const int levels = MipChain::LevelCount(width, height);
+    for (int level = 0; level < levels; ++level) {
+        CompressImage(chain + MipChain::LevelOffset(width, height, level), MipChain::LevelSize(width, level),
+                      MipChain::LevelSize(height, level), out + LevelOffset(width, height, level));
+    }
+}
+
+void BC1Encoder::DecompressImage(const unsigned char *blocks, int width, int height, unsigned char *out) {
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            const uint16_t color0 = (uint16_t) (blocks[0] | (blocks[1] << 8));
+            const uint16_t color1 = (uint16_t) (blocks[2] | (blocks[3] << 8));
+            const uint32_t indices = (uint32_t) blocks[4] | ((uint32_t) blocks[5] << 8) |
+                                     ((uint32_t) blocks[6] << 16) | ((uint32_t) blocks[7] << 24);
+            int palette[4][3];
+            fromRGB565(color0, palette[0]);
+            fromRGB565(color1, palette[1]);
+            for (int c = 0; c < 3; ++c) {
+                if (color0 > color1) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                } else {
+                    // Three colour mode; its transparent black entry is decoded as opaque black
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+            for (int row = 0; row < 4 && by + row < height; ++row) {
+                for (int col = 0; col < 4 && bx + col < width; ++col) {
+                    const int *color = palette[(indices >> (2 * (row * 4 + col))) & 3];
+                    unsigned char *pixel = out + ((size_t) (by + row) * width + bx + col) * 4;
+                    for (int c = 0; c < 3; ++c) pixel[c] = (unsigned char) color[c];
+                    pixel[3] = 255;
+                }
+            }
+            blocks += BLOCK_BYTES;
+        }
+    }
+}
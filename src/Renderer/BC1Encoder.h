@@ -0,0 +1,71 @@
+/**
+ * @file BC1Encoder.h
+ * @brief Real-time BC1 (S3TC DXT1) compression of RGBA8 images and mipmap chains.
+ * BC1 stores each 4x4 pixel block in 8 bytes: two RGB565 endpoints and a 2-bit palette index
+ * per pixel, so an RGBA8 image shrinks 8 times. Alpha is dropped, which suits the opaque ball textures.
+ * Images can be decompressed again, for the rare edits that need pixels, such as resampling.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_BC1ENCODER_H
+#define BILLIARDSHOW_BC1ENCODER_H
+
+#pragma once
+
+#include <cstddef>
+
+namespace BC1Encoder {
+    // Bytes per compressed 4x4 block
+    constexpr size_t BLOCK_BYTES = 8;
+
+    /**
+     * @brief Gets the compressed size of one image; partial blocks at the edges count as whole blocks.
+     */
+    size_t ImageBytes(int width, int height);
+
+    /**
+     * @brief Gets the byte offset of a level within a compressed chain (see MipChain for the level sizes).
+     * LevelOffset(width, height, MipChain::LevelCount(width, height)) is the size of the whole chain.
+     */
+    size_t LevelOffset(int width, int height, int level);
+
+    /**
+     * @brief Compresses one 4x4 block.
+     * Endpoints come from the inset bounding box of the block's colours, with the box diagonal
+     * chosen from the sign of the colour covariance; pixels are then projected onto the endpoint line.
+     * Uses SSE2 on x86 and plain C++ elsewhere, with identical results.
+     * @param rgba 16 RGBA8 pixels, row by row.
+     * @param out Receives the 8 byte block.
+     */
+    void CompressBlock(const unsigned char *rgba, unsigned char *out);
+
+    /**
+     * @brief Compresses an RGBA8 image; edge blocks repeat the last row and column.
+     * @param rgba Source pixels.
+     * @param width Width in pixels.
+     * @param height Height in pixels.
+     * @param out Receives ImageBytes(width, height) bytes.
+     */
+    void CompressImage(const unsigned char *rgba, int width, int height, unsigned char *out);
+
+    /**
+     * @brief Compresses every level of an RGBA8 mipmap chain laid out as by MipChain.
+     * @param chain Source chain.
+     * @param width Width of level 0 in pixels.
+     * @param height Height of level 0 in pixels.
+     * @param out Receives the compressed chain, laid out as by LevelOffset().
+     */
+    void CompressChain(const unsigned char *chain, int width, int height, unsigned char *out);
+
+    /**
+     * @brief Decompresses a BC1 image to RGBA8 with opaque alpha.
+     * @param blocks ImageBytes(width, height) bytes of compressed blocks.
+     * @param width Width in pixels.
+     * @param height Height in pixels.
+     * @param out Receives width * height * 4 bytes.
+     */
+    void DecompressImage(const unsigned char *blocks, int width, int height, unsigned char *out);
+}
+
+#endif //BILLIARDSHOW_BC1ENCODER_H
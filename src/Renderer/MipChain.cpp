@@ -0,0 +1,146 @@
+/**
+ * @file MipChain.cpp
+ * @brief Implementation of the mipmap chain builder.
+ * The vector paths average 2x2 blocks in 16-bit lanes and round to nearest, so they produce
+ * exactly the same bytes as the scalar path.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MipChain.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define MIPCHAIN_X86 1
+#include <immintrin.h>
+#endif
+
+int MipChain::LevelCount(int width, int height) {
+    int levels = 1;
+    for (int size = width > height ? width : height; size > 1; size >>= 1) ++levels;
+    return levels;
+}
+
+size_t MipChain::LevelOffset(int width, int height, int level) {
+    size_t offset = 0;
+    for (int i = 0; i < level; ++i)
+        offset += (size_t) LevelSize(width, i) * (size_t) LevelSize(height, i) * 4;
+    return offset;
+}
+
+size_t MipChain::ChainBytes(int width, int height) {
+    return LevelOffset(width, height, LevelCount(width, height));
+}
+
+/**
+ * @brief Averages destination pixels [x, dstWidth) of one row from two source rows, with clamping.
+ */
+static void downsampleRowScalar(const unsigned char *row0, const unsigned char *row1, int srcWidth,
+                                unsigned char *dst, int x, int dstWidth) {
+    for (; x < dstWidth; ++x) {
+        int x0 = 2 * x < srcWidth ? 2 * x : srcWidth - 1;
+        int x1 = 2 * x + 1 < srcWidth ? 2 * x + 1 : srcWidth - 1;
+        for (int c = 0; c < 4; ++c) {
+            unsigned sum = row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] + row1[x1 * 4 + c];
+            dst[x * 4 + c] = (unsigned char) ((sum + 2) >> 2);
+        }
+    }
+}
+
+#ifdef MIPCHAIN_X86
+
+/**
+ * @brief SSE2 row kernel: 4 destination pixels per iteration. Returns the first pixel not written.
+ */
+static int downsampleRowSSE2(const unsigned char *row0, const unsigned char *row1, unsigned char *dst,
+                             int dstWidth) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    int x = 0;
+    for (; x + 4 <= dstWidth; x += 4) {
+        __m128i a0 = _mm_loadu_si128((const __m128i *) (row0 + x * 8));
+        __m128i a1 = _mm_loadu_si128((const __m128i *) (row0 + x * 8 + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i *) (row1 + x * 8));
+        __m128i b1 = _mm_loadu_si128((const __m128i *) (row1 + x * 8 + 16));
+        // Vertical sums, two source pixels per register
+        __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+        // Horizontal sums: even source pixels plus odd source pixels
+        __m128i q01 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+        __m128i q23 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+        q01 = _mm_srli_epi16(_mm_add_epi16(q01, two), 2);
+        q23 = _mm_srli_epi16(_mm_add_epi16(q23, two), 2);
+        _mm_storeu_si128((__m128i *) (dst + x * 4), _mm_packus_epi16(q01, q23));
+    }
+    return x;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MIPCHAIN_AVX2 1
+
+/**
+ * @brief AVX2 row kernel: 8 destination pixels per iteration. Returns the first pixel not written.
+ * Compiled for AVX2 regardless of the build flags and only called after a CPU check.
+ */
+__attribute__((target("avx2")))
+static int downsampleRowAVX2(const unsigned char *row0, const unsigned char *row1, unsigned char *dst,
+                             int dstWidth) {
+    const __m256i two = _mm256_set1_epi16(2);
+    // packus works per 128-bit lane, which leaves the pixels in the order 0 2 4 6 1 3 5 7
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    int x = 0;
+    for (; x + 8 <= dstWidth; x += 8) {
+        __m256i s[4];
+        for (int i = 0; i < 4; ++i) {
+            __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (row0 + x * 8 + i * 16)));
+            __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (row1 + x * 8 + i * 16)));
+            s[i] = _mm256_add_epi16(a, b);
+        }
+        __m256i q0 = _mm256_add_epi16(_mm256_unpacklo_epi64(s[0], s[1]), _mm256_unpackhi_epi64(s[0], s[1]));
+        __m256i q1 = _mm256_add_epi16(_mm256_unpacklo_epi64(s[2], s[3]), _mm256_unpackhi_epi64(s[2], s[3]));
+        q0 = _mm256_srli_epi16(_mm256_add_epi16(q0, two), 2);
+        q1 = _mm256_srli_epi16(_mm256_add_epi16(q1, two), 2);
+        __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(q0, q1), order);
+        _mm256_storeu_si256((__m256i *) (dst + x * 4), packed);
+    }
+    return x;
+}
+
+static bool hasAVX2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+#endif
+
+void MipChain::Downsample(const unsigned char *src, int srcWidth, int srcHeight, unsigned char *dst) {
+    const int dstWidth = LevelSize(srcWidth, 1);
+    const int dstHeight = LevelSize(srcHeight, 1);
+    const size_t srcStride = (size_t) srcWidth * 4;
+    for (int y = 0; y < dstHeight; ++y) {
+        const unsigned char *row0 = src + (size_t) (2 * y < srcHeight ? 2 * y : srcHeight - 1) * srcStride;
+        const unsigned char *row1 = src + (size_t) (2 * y + 1 < srcHeight ? 2 * y + 1 : srcHeight - 1) * srcStride;
+        unsigned char *out = dst + (size_t) y * dstWidth * 4;
+        int x = 0;
+#ifdef MIPCHAIN_X86
+        // The vector kernels read pixel pairs without clamping, which needs at least two source columns
+        if (srcWidth >= 2) {
+#ifdef MIPCHAIN_AVX2
+            if (hasAVX2()) x = downsampleRowAVX2(row0, row1, out, dstWidth);
+#endif
+            x += downsampleRowSSE2(row0 + x * 8, row1 + x * 8, out + x * 4, dstWidth - x);
+        }
+#endif
+        downsampleRowScalar(row0, row1, srcWidth, out, x, dstWidth);
+    }
+}
+
+void MipChain::Build(unsigned char *chain, int width, int height) {
+    const int levels = LevelCount(width, height);
+    for (int level = 1; level < levels; ++level) {
+        Downsample(chain + LevelOffset(width, height, level - 1), LevelSize(width, level - 1),
+                   LevelSize(height, level - 1), chain + LevelOffset(width, height, level));
+    }
+}
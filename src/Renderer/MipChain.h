@@ -0,0 +1,61 @@
+/**
+ * @file MipChain.h
+ * @brief CPU generation of RGBA8 mipmap chains.
+ * A chain is stored in one contiguous buffer, full resolution first, each level directly after the
+ * previous one, so it can be copied into a pixel buffer with a single memcpy and uploaded level by
+ * level from offsets into it.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MIPCHAIN_H
+#define BILLIARDSHOW_MIPCHAIN_H
+
+#pragma once
+
+#include <cstddef>
+
+namespace MipChain {
+    /**
+     * @brief Gets the number of levels of a full chain, down to 1x1.
+     */
+    int LevelCount(int width, int height);
+
+    /**
+     * @brief Gets the size of a level along one axis.
+     */
+    inline int LevelSize(int size, int level) { return (size >> level) > 0 ? (size >> level) : 1; }
+
+    /**
+     * @brief Gets the byte offset of a level within a chain buffer.
+     * LevelOffset(width, height, LevelCount(width, height)) is the size of the whole chain.
+     */
+    size_t LevelOffset(int width, int height, int level);
+
+    /**
+     * @brief Gets the size in bytes of a full chain.
+     */
+    size_t ChainBytes(int width, int height);
+
+    /**
+     * @brief Halves an RGBA8 image with a 2x2 box filter.
+     * The destination has LevelSize(srcWidth, 1) x LevelSize(srcHeight, 1) pixels; with an odd
+     * source size the last row or column is dropped, and a source size of 1 is clamped.
+     * Uses AVX2 when the CPU has it, SSE2 otherwise, and plain C++ on other architectures.
+     * @param src Source pixels.
+     * @param srcWidth Source width in pixels.
+     * @param srcHeight Source height in pixels.
+     * @param dst Destination pixels; must not overlap the source.
+     */
+    void Downsample(const unsigned char *src, int srcWidth, int srcHeight, unsigned char *dst);
+
+    /**
+     * @brief Fills levels 1 and up of a chain buffer from level 0.
+     * @param chain Buffer of ChainBytes(width, height) bytes whose first level holds the image.
+     * @param width Width of level 0 in pixels.
+     * @param height Height of level 0 in pixels.
+     */
+    void Build(unsigned char *chain, int width, int height);
+}
+
+#endif //BILLIARDSHOW_MIPCHAIN_H
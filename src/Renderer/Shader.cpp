@@ -9,26 +9,31 @@
  * @date 2025-05-27
  */
 #include "Shader.h"
+#include "../Utils/AssetArchive.h"
+#include "../Utils/DerivedCache.h"
+#include "../Utils/Hash.h"
+#include "../Utils/Logger.h"
+
+#include <cstring>
+#include <vector>
 
 // Static member to keep track of the currently active shader
 Shader *Shader::activeShader = nullptr;
 
 /**
  * @fn readFile
- * @brief Reads the contents of a shader file.
+ * @brief Reads the contents of a shader file, from the asset archive or the file system.
  * @param path The file path to the shader source.
  * @return The contents of the file as a string.
  * If the file cannot be opened, an error message is printed and an empty string is returned.
  */
 static std::string readFile(const std::string &path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    AssetFile file;
+    if (!file.Open(path)) {
         std::cerr << "Shader file not found: " << path << std::endl;
         return "";
     }
-    std::stringstream ss;
-    ss << file.rdbuf();
-    return ss.str();
+    return std::string(file.Data(), file.Size());
 }
 
 /**
@@ -37,10 +42,11 @@ static std::string readFile(const std::string &path) {
  * @param type The type of shader (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER).
  * @param src The source code of the shader.
  * @param path The file path for error reporting.
+ * @param ok Set to false if compilation fails.
  * @return The compiled shader ID.
  * If compilation fails, an error message is printed and the shader ID is returned.
  */
-static GLuint compileShader(GLenum type, const std::string &src, const std::string &path) {
+static GLuint compileShader(GLenum type, const std::string &src, const std::string &path, bool &ok) {
     GLuint shader = glCreateShader(type);
     const char *csrc = src.c_str();
     glShaderSource(shader, 1, &csrc, nullptr);
@@ -52,16 +58,116 @@ static GLuint compileShader(GLenum type, const std::string &src, const std::stri
         glGetShaderInfoLog(shader, 2048, nullptr, info);
         std::cerr << "Shader compile error in " << path << ":\n" << info << std::endl;
         std::cerr << "Shader source:\n" << src << std::endl;
+        ok = false;
     }
     return shader;
 }
 
+/**
+ * @fn programBinaryKey
+ * @brief Gets the derived-cache key of a program binary, or 0 if the driver cannot return binaries.
+ * Binaries are only valid for the driver that produced them, so the driver strings are part of the key.
+ */
+static uint64_t programBinaryKey(const std::string &vsrc, const std::string &fsrc) {
+    if (!DerivedCache::Instance().IsEnabled() || !(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)) return 0;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) return 0;
+    std::string driver;
+    for (GLenum name: {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const auto *value = reinterpret_cast<const char *>(glGetString(name));
+        if (value) driver.append(value).push_back('\n');
+    }
+    return DerivedCache::Key("program", 1, {Hash::XXH64(vsrc.data(), vsrc.size()),
+                                            Hash::XXH64(fsrc.data(), fsrc.size()),
+                                            Hash::XXH64(driver.data(), driver.size())});
+}
+
+/**
+ * @fn loadProgramBinary
+ * @brief Creates a program from a cached binary.
+ * Layout of the entry: the binary format as a 32-bit value, then the binary.
+ * @return The program ID, or 0 on a miss or if the driver rejects the binary.
+ */
+static GLuint loadProgramBinary(uint64_t key) {
+    MappedFile entry;
+    if (!DerivedCache::Instance().Open(key, "program", entry) || entry.Size() <= sizeof(uint32_t)) return 0;
+    uint32_t binaryFormat;
+    std::memcpy(&binaryFormat, entry.Data(), sizeof(binaryFormat));
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, binaryFormat, entry.Data() + sizeof(binaryFormat),
+                    (GLsizei) (entry.Size() - sizeof(binaryFormat)));
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // Drivers may reject their own binaries after an update that kept the version string
+        Logger::Warn("Driver rejected cached program binary, compiling from source");
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/**
+ * @fn storeProgramBinary
+ * @brief Reads back the binary of a linked program and stores it in the derived-asset cache.
+ */
+static void storeProgramBinary(uint64_t key, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<std::byte> binary((size_t) length);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+    if (glGetError() != GL_NO_ERROR || length <= 0) return;
+    const uint32_t format = binaryFormat;
+    DerivedCache::Instance().Store(key, "program", {std::as_bytes(std::span(&format, 1)),
+                                                    std::span(binary.data(), (size_t) length)});
+}
+
+/**
+ * @fn linkProgram
+ * @brief Compiles both stages and links them into a new program.
+ * When the driver supports program binaries, a binary cached for the same sources and driver is
+ * loaded instead, and a freshly linked program is cached for the next run.
+ * @param ok Set to false if a stage fails to compile or the program fails to link.
+ * @return The program ID, also on failure.
+ */
+static GLuint linkProgram(const std::string &vsrc, const std::string &fsrc, const std::string &vertexPath,
+                          const std::string &fragmentPath, bool &ok) {
+    ok = true;
+    const uint64_t binaryKey = programBinaryKey(vsrc, fsrc);
+    if (binaryKey) {
+        if (GLuint program = loadProgramBinary(binaryKey)) return program;
+    }
+    GLuint vshader = compileShader(GL_VERTEX_SHADER, vsrc, vertexPath, ok);
+    GLuint fshader = compileShader(GL_FRAGMENT_SHADER, fsrc, fragmentPath, ok);
+    GLuint program = glCreateProgram();
+    if (binaryKey) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(program, vshader);
+    glAttachShader(program, fshader);
+    glLinkProgram(program);
+    glDeleteShader(vshader);
+    glDeleteShader(fshader);
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info[2048];
+        glGetProgramInfoLog(program, 2048, nullptr, info);
+        std::cerr << "Shader link error in " << vertexPath << " + " << fragmentPath << ":\n" << info << std::endl;
+        ok = false;
+    }
+    if (ok && binaryKey) storeProgramBinary(binaryKey, program);
+    return program;
+}
+
 /**
  * @class Shader
  * @brief Represents an OpenGL shader program.
  * Handles shader compilation, linking, and uniform management.
  */
-Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath) {
+Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath)
+        : vertexPath(vertexPath), fragmentPath(fragmentPath) {
     std::string vsrc = readFile(vertexPath);
     std::string fsrc = readFile(fragmentPath);
     if (vsrc.empty()) {
@@ -70,14 +176,52 @@ Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath) {
     if (fsrc.empty()) {
         std::cerr << "Fragment shader source is empty! Path: " << fragmentPath << std::endl;
     }
-    GLuint vshader = compileShader(GL_VERTEX_SHADER, vsrc, vertexPath);
-    GLuint fshader = compileShader(GL_FRAGMENT_SHADER, fsrc, fragmentPath);
-    programID = glCreateProgram();
-    glAttachShader(programID, vshader);
-    glAttachShader(programID, fshader);
-    glLinkProgram(programID);
-    glDeleteShader(vshader);
-    glDeleteShader(fshader);
+    bool ok;
+    programID = linkProgram(vsrc, fsrc, vertexPath, fragmentPath, ok);
+}
+
+/**
+ * @fn ReadSource
+ * @brief Reads a shader source file; safe to call from any thread.
+ */
+std::string Shader::ReadSource(const std::string &path) {
+    return readFile(path);
+}
+
+/**
+ * @fn Reload
+ * @brief Rebuilds the program from new sources, keeping the old program if they do not compile or link.
+ * Uniform values belong to the program, so the caller sets them again, as the render loop does every frame.
+ * @param vertexSource The new vertex shader source.
+ * @param fragmentSource The new fragment shader source.
+ * @return True if the new program replaced the old one.
+ */
+bool Shader::Reload(const std::string &vertexSource, const std::string &fragmentSource) {
+    if (vertexSource.empty() || fragmentSource.empty()) {
+        Logger::Warn("Keeping shader " + fragmentPath + ": a source file is empty or missing");
+        return false;
+    }
+    bool ok;
+    GLuint program = linkProgram(vertexSource, fragmentSource, vertexPath, fragmentPath, ok);
+    if (!ok) {
+        glDeleteProgram(program);
+        Logger::Warn("Keeping the previous program for " + vertexPath + " + " + fragmentPath);
+        return false;
+    }
+    glDeleteProgram(programID);
+    programID = program;
+    if (activeShader == this) glUseProgram(programID);
+    Logger::Info("Reloaded shader " + vertexPath + " + " + fragmentPath);
+    return true;
+}
+
+/**
+ * @fn Reload
+ * @brief Reads both source files again and rebuilds the program from them.
+ * @return True if the new program replaced the old one.
+ */
+bool Shader::Reload() {
+    return Reload(readFile(vertexPath), readFile(fragmentPath));
 }
 
 Shader::~Shader() {
@@ -127,6 +271,17 @@ void Shader::setVec3(const std::string &name, const glm::vec3 &value) const {
     glUniform3fv(loc, 1, &value[0]);
 }
 
+/**
+ * @fn setVec2
+ * @brief Sets a 2D vector uniform in the shader.
+ * @param name The name of the uniform variable.
+ * @param value The vector to set.
+ */
+void Shader::setVec2(const std::string &name, const glm::vec2 &value) const {
+    GLint loc = glGetUniformLocation(programID, name.c_str());
+    glUniform2fv(loc, 1, &value[0]);
+}
+
 /**
  * @fn setBool
  * @brief Sets a boolean uniform in the shader.
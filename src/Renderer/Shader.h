@@ -34,6 +34,38 @@ public:
 
     ~Shader();
 
+    /**
+     * @fn Reload
+     * @brief Rebuilds the program from its source files.
+     * If the new sources fail to compile or link, the previous program stays in use.
+     * Must be called on the thread that owns the OpenGL context.
+     * @return True if the program was replaced.
+     */
+    bool Reload();
+
+    /**
+     * @fn Reload
+     * @brief Rebuilds the program from sources that were read beforehand, e.g. on a worker thread.
+     * If the sources fail to compile or link, the previous program stays in use.
+     * @param vertexSource The vertex shader source.
+     * @param fragmentSource The fragment shader source.
+     * @return True if the program was replaced.
+     */
+    bool Reload(const std::string &vertexSource, const std::string &fragmentSource);
+
+    /**
+     * @fn ReadSource
+     * @brief Reads a shader source file from the asset archive or the file system.
+     * Makes no OpenGL calls, so it may run on any thread.
+     * @param path The path to the source file.
+     * @return The source, or an empty string if the file cannot be read.
+     */
+    static std::string ReadSource(const std::string &path);
+
+    const std::string &GetVertexPath() const { return vertexPath; }
+
+    const std::string &GetFragmentPath() const { return fragmentPath; }
+
     /**
      * @fn use
      * @brief Activates the shader program for rendering.
@@ -65,6 +97,14 @@ public:
      */
     void setVec3(const std::string &name, const glm::vec3 &value) const;
 
+    /**
+     * @fn setVec2
+     * @brief Sets a vec2 uniform in the shader.
+     * @param name The name of the uniform variable.
+     * @param value The vec2 value to set.
+     */
+    void setVec2(const std::string &name, const glm::vec2 &value) const;
+
     /**
      * @fn setBool
      * @brief Sets a boolean uniform in the shader.
@@ -97,6 +137,8 @@ public:
 
 private:
     GLuint programID;
+    std::string vertexPath;
+    std::string fragmentPath;
     static Shader *activeShader;
 };
 
@@ -10,46 +10,344 @@
 
 #include "../../third_party/stb_image.h"
 #include "Texture.h"
+#include "TextureUploader.h"
+#include "MipChain.h"
+#include "BC1Encoder.h"
+#include "TextureBlob.h"
+#include "../Utils/AssetArchive.h"
+#include "../Utils/Hash.h"
+#include "../Utils/LoadProgress.h"
 #include "../Utils/Logger.h"
 #include <GL/glew.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * @struct DecodeStream
+ * @brief Asset source for stb_image's callback interface that counts bytes and honours a stop token.
+ */
+struct DecodeStream {
+    std::span<const std::byte> bytes;
+    size_t position;
+    std::stop_token stop;
+    LoadProgress *progress;
+};
+
+static int streamRead(void *user, char *data, int size) {
+    auto *stream = static_cast<DecodeStream *>(user);
+    if (stream->stop.stop_requested()) return 0; // Looks like end of file, so stb_image gives up
+    size_t read = std::min((size_t) size, stream->bytes.size() - stream->position);
+    std::memcpy(data, stream->bytes.data() + stream->position, read);
+    stream->position += read;
+    if (stream->progress) stream->progress->Advance(read);
+    return (int) read;
+}
+
+static void streamSkip(void *user, int n) {
+    auto *stream = static_cast<DecodeStream *>(user);
+    if (n < 0) {
+        stream->position -= std::min((size_t) -(int64_t) n, stream->position);
+        return;
+    }
+    size_t skipped = std::min((size_t) n, stream->bytes.size() - stream->position);
+    stream->position += skipped;
+    if (stream->progress) stream->progress->Advance(skipped);
+}
+
+static int streamEof(void *user) {
+    auto *stream = static_cast<DecodeStream *>(user);
+    return stream->stop.stop_requested() || stream->position >= stream->bytes.size();
+}
+
+std::atomic<bool> Texture::compressionEnabled{false};
+
 // Constructor and Destructor
 Texture::Texture() {}
 
 Texture::~Texture() {
+    TextureUploader::Instance().Cancel(this);
+    FreeStaging();
     if (id) glDeleteTextures(1, &id);
 }
 
+/**
+ * @fn FreeStaging
+ * @brief Frees the decoded staging image, if any.
+ */
+void Texture::FreeStaging() {
+    if (staging) {
+        stbi_image_free(staging);
+        staging = nullptr;
+    }
+}
+
 /**
  * @fn LoadFromFile
  * @brief Loads a texture from a file.
- * This method loads a texture from a file using the stb_image library.
- * It generates a new OpenGL texture ID and binds it to the current context.
- * It then sets texture parameters and uploads the texture data.
- * It then unbinds the texture and returns the texture ID.
- * If an error occurs during loading, the texture ID is set to 0 and false is returned.
+ * This method decodes the file with the stb_image library and immediately uploads it
+ * to a new OpenGL texture. Use Decode() and Upload() separately to keep decoding off the GL thread.
  * @param path The path to the texture file.
  * @return True if the texture was loaded successfully, false otherwise.
  */
 bool Texture::LoadFromFile(const std::string &path) {
+    return Decode(path) && Upload();
+}
+
+/**
+ * @fn SetCompression
+ * @brief Enables or disables BC1 compression for images decoded from now on.
+ */
+void Texture::SetCompression(bool enabled) {
+    compressionEnabled = enabled;
+}
+
+/**
+ * @fn IsCompressedFormat
+ * @brief Checks whether an internal format is one of the block-compressed formats textures use.
+ */
+bool Texture::IsCompressedFormat(GLenum format) {
+    return format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+}
+
+/**
+ * @fn LevelOffset
+ * @brief Gets the byte offset of a mipmap level within a staging chain of the given format.
+ */
+size_t Texture::LevelOffset(GLenum format, int width, int height, int level) {
+    return IsCompressedFormat(format) ? BC1Encoder::LevelOffset(width, height, level)
+                                      : MipChain::LevelOffset(width, height, level);
+}
+
+/**
+ * @fn Decode
+ * @brief Decodes an image file into CPU staging memory.
+ * The image is always expanded to RGBA8 and followed by its mipmap chain. No OpenGL calls are made.
+ * With compression enabled, opaque images are then compressed to BC1. The finished chain is cached
+ * in a texture blob keyed by the file contents, and later decodes of the same file copy the blob
+ * instead of decoding the image.
+ * Building the chain here keeps it on the decode worker and off the GL thread, and avoids
+ * glGenerateMipmap, which is slow on software drivers such as llvmpipe.
+ * The file, a view into the asset archive or a mapped loose file, is fed to stb_image through
+ * callbacks in small blocks, so a stop request ends the decode at the next block and the
+ * progress counter follows the bytes actually consumed.
+ * @param path The path to the texture file.
+ * @param stop Token that cancels the decode.
+ * @param progress Advanced by the number of file bytes read, if not null.
+ * @return True if the image was decoded successfully, false otherwise.
+ */
+bool Texture::Decode(const std::string &path, std::stop_token stop, LoadProgress *progress) {
+    FreeStaging();
+    AssetFile file;
+    if (!file.Open(path)) {
+        Logger::Error("Failed to open image: " + path);
+        return false;
+    }
+    const bool compress = compressionEnabled;
+    const uint64_t blobKey = TextureBlob::KeyFor(Hash::XXH64(file.Data(), file.Size()), compress);
+    if (LoadBlob(blobKey, path, file.Size(), stop, progress)) return true;
+    if (stop.stop_requested()) return false;
+    DecodeStream stream{file.Bytes(), 0, stop, progress};
+    const stbi_io_callbacks callbacks{streamRead, streamSkip, streamEof};
     int n;
-    unsigned char *data = stbi_load(path.c_str(), &width, &height, &n, STBI_rgb_alpha);
-    if (!data) {
-        Logger::Error("Failed to load image: " + path);
+    staging = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &n, STBI_rgb_alpha);
+    if (!staging) {
+        if (stop.stop_requested()) Logger::Info("Cancelled decoding image: " + path);
+        else Logger::Error("Failed to load image: " + path + " (" + stbi_failure_reason() + ")");
+        return false;
+    }
+    sourcePath = path;
+    // stb_image allocates with malloc, so the buffer can grow in place to hold the whole chain
+    auto *chain = static_cast<unsigned char *>(std::realloc(staging, MipChain::ChainBytes(width, height)));
+    if (!chain) {
+        Logger::Error("Out of memory while building mipmaps: " + path);
+        FreeStaging();
         return false;
     }
+    staging = chain;
+    format = GL_RGBA8;
+    levelCount = MipChain::LevelCount(width, height);
+    MipChain::Build(staging, width, height);
+    if (compress && IsOpaque(n)) Compress();
+    TextureBlob::Write(blobKey, format, width, height, levelCount, staging,
+                       LevelOffset(format, width, height, levelCount));
+    return true;
+}
+
+/**
+ * @fn IsOpaque
+ * @brief Checks whether the decoded image has no transparent pixels, so BC1 can drop its alpha.
+ * @param channels Number of channels in the file, as reported by stb_image.
+ */
+bool Texture::IsOpaque(int channels) const {
+    if (channels != 2 && channels != 4) return true;
+    const size_t pixels = (size_t) width * (size_t) height;
+    for (size_t i = 0; i < pixels; ++i)
+        if (staging[i * 4 + 3] != 255) return false;
+    return true;
+}
+
+/**
+ * @fn Compress
+ * @brief Replaces the RGBA8 staging chain with its BC1 compression.
+ */
+void Texture::Compress() {
+    const GLenum compressed = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    const size_t bytes = LevelOffset(compressed, width, height, levelCount);
+    auto *blocks = static_cast<unsigned char *>(std::malloc(bytes));
+    if (!blocks) {
+        Logger::Warn("Out of memory while compressing image, keeping it uncompressed: " + sourcePath);
+        return;
+    }
+    BC1Encoder::CompressChain(staging, width, height, blocks);
+    FreeStaging();
+    staging = blocks;
+    format = compressed;
+}
+
+/**
+ * @fn LoadBlob
+ * @brief Copies the mipmap chain of a cached texture blob into staging memory.
+ * The copy runs in blocks so a stop request is honoured and progress advances smoothly; the
+ * progress counter is advanced by the size of the source file, which is what the load measured.
+ * @return True if the blob was found and copied; false if the image has to be decoded instead.
+ */
+bool Texture::LoadBlob(uint64_t key, const std::string &path, uint64_t sourceSize, std::stop_token stop,
+                       LoadProgress *progress) {
+    TextureBlob blob;
+    if (!blob.Open(key)) return false;
+    const TextureBlob::Header &h = blob.GetHeader();
+    const int w = (int) h.width, ht = (int) h.height;
+    if ((h.format != GL_RGBA8 && !IsCompressedFormat(h.format)) || (int) h.levelCount != MipChain::LevelCount(w, ht) ||
+        h.dataSize != LevelOffset(h.format, w, ht, (int) h.levelCount)) {
+        Logger::Warn("Ignoring texture blob that does not match its header: " + blob.GetPath());
+        return false;
+    }
+    auto *blocks = static_cast<unsigned char *>(std::malloc(h.dataSize));
+    if (!blocks) return false;
+    constexpr size_t CHUNK = 1u << 20;
+    uint64_t advanced = 0;
+    for (size_t copied = 0; copied < h.dataSize; copied += CHUNK) {
+        if (stop.stop_requested()) {
+            Logger::Info("Cancelled loading texture blob: " + blob.GetPath());
+            std::free(blocks);
+            return false;
+        }
+        const size_t n = std::min(CHUNK, (size_t) h.dataSize - copied);
+        std::memcpy(blocks + copied, blob.Data() + copied, n);
+        if (progress) {
+            const uint64_t target = sourceSize * (copied + n) / h.dataSize;
+            progress->Advance(target - advanced);
+            advanced = target;
+        }
+    }
+    staging = blocks;
+    width = w;
+    height = ht;
+    levelCount = (int) h.levelCount;
+    format = h.format;
+    sourcePath = path;
+    return true;
+}
+
+/**
+ * @fn Resample
+ * @brief Resizes the decoded staging image with bilinear filtering and rebuilds its mipmap chain.
+ * Pixel centres are mapped onto each other, so a 2:1 reduction averages pixel pairs.
+ * A BC1 image is decompressed, resampled and compressed again, so it keeps its format.
+ * The new chain is allocated with malloc, which is what stbi_image_free releases.
+ */
+bool Texture::Resample(int newWidth, int newHeight) {
+    if (!staging || newWidth <= 0 || newHeight <= 0) return false;
+    if (newWidth == width && newHeight == height) return true;
+    const GLenum sourceFormat = format;
+    std::vector<unsigned char> decoded;
+    const unsigned char *source = staging;
+    if (IsCompressedFormat(format)) {
+        decoded.resize((size_t) width * (size_t) height * 4);
+        BC1Encoder::DecompressImage(staging, width, height, decoded.data());
+        source = decoded.data();
+    }
+    auto *resized = static_cast<unsigned char *>(std::malloc(MipChain::ChainBytes(newWidth, newHeight)));
+    if (!resized) {
+        Logger::Error("Out of memory while resampling image: " + sourcePath);
+        return false;
+    }
+    const float sx = (float) width / (float) newWidth;
+    const float sy = (float) height / (float) newHeight;
+    for (int y = 0; y < newHeight; ++y) {
+        float fy = std::max(0.0f, ((float) y + 0.5f) * sy - 0.5f);
+        int y0 = std::min((int) fy, height - 1);
+        int y1 = std::min(y0 + 1, height - 1);
+        float wy = fy - (float) y0;
+        for (int x = 0; x < newWidth; ++x) {
+            float fx = std::max(0.0f, ((float) x + 0.5f) * sx - 0.5f);
+            int x0 = std::min((int) fx, width - 1);
+            int x1 = std::min(x0 + 1, width - 1);
+            float wx = fx - (float) x0;
+            const unsigned char *p00 = source + ((size_t) y0 * width + x0) * 4;
+            const unsigned char *p01 = source + ((size_t) y0 * width + x1) * 4;
+            const unsigned char *p10 = source + ((size_t) y1 * width + x0) * 4;
+            const unsigned char *p11 = source + ((size_t) y1 * width + x1) * 4;
+            unsigned char *out = resized + ((size_t) y * newWidth + x) * 4;
+            for (int c = 0; c < 4; ++c) {
+                float top = p00[c] + (p01[c] - p00[c]) * wx;
+                float bottom = p10[c] + (p11[c] - p10[c]) * wx;
+                out[c] = (unsigned char) (top + (bottom - top) * wy + 0.5f);
+            }
+        }
+    }
+    Logger::Info("Resampled " + sourcePath + " from " + std::to_string(width) + "x" + std::to_string(height) +
+                 " to " + std::to_string(newWidth) + "x" + std::to_string(newHeight));
+    MipChain::Build(resized, newWidth, newHeight);
+    FreeStaging();
+    staging = resized;
+    width = newWidth;
+    height = newHeight;
+    levelCount = MipChain::LevelCount(newWidth, newHeight);
+    format = GL_RGBA8;
+    if (IsCompressedFormat(sourceFormat)) Compress();
+    if (format != sourceFormat) {
+        Logger::Error("Could not compress resampled image again: " + sourcePath);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @fn Upload
+ * @brief Uploads the decoded staging image to a new OpenGL texture.
+ * It generates a new OpenGL texture ID, sets texture parameters and uploads the pixels.
+ * The staging memory is freed whether or not the upload succeeds.
+ * If an error occurs, the texture ID is set to 0 and false is returned.
+ * @return True if the texture was uploaded successfully, false otherwise.
+ */
+bool Texture::Upload() {
+    if (!staging) {
+        Logger::Error("Texture::Upload called without a decoded image");
+        return false;
+    }
+    if (id) glDeleteTextures(1, &id);
     glGenTextures(1, &id);
     glBindTexture(GL_TEXTURE_2D, id);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    SetMipmapSampling(GL_TEXTURE_2D, levelCount);
+    for (int level = 0; level < levelCount; ++level) {
+        const int w = MipChain::LevelSize(width, level);
+        const int h = MipChain::LevelSize(height, level);
+        const size_t offset = LevelOffset(format, width, height, level);
+        if (IsCompressedFormat(format))
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, format, w, h, 0,
+                                   (GLsizei) (LevelOffset(format, width, height, level + 1) - offset), staging + offset);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, staging + offset);
+    }
     GLenum err = glGetError();
     glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
+    FreeStaging();
     if (err != GL_NO_ERROR) {
-        Logger::Error("OpenGL error after loading texture: " + std::to_string(err) + ", path: " + path);
+        Logger::Error("OpenGL error after loading texture: " + std::to_string(err) + ", path: " + sourcePath);
         glDeleteTextures(1, &id);
         id = 0;
         return false;
@@ -57,6 +355,20 @@ bool Texture::LoadFromFile(const std::string &path) {
     return id != 0;
 }
 
+/**
+ * @fn SetMipmapSampling
+ * @brief Sets trilinear filtering, edge clamping and the mipmap range on the texture bound to a target.
+ * Limiting the maximum level keeps the texture complete before every level has been specified.
+ */
+void Texture::SetMipmapSampling(GLenum target, int levelCount) {
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+}
+
 /**
  * @fn Bind
  * @brief Binds the texture to the current OpenGL context.
@@ -86,6 +398,8 @@ bool Texture::IsValid() const {
  * If the texture is already released, it logs a warning.
  */
 void Texture::Release() {
+    TextureUploader::Instance().Cancel(this);
+    FreeStaging();
     if (id != 0) {
         glDeleteTextures(1, &id);
         id = 0;
@@ -13,9 +13,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <stop_token>
 #include <string>
 #include <GL/glew.h>
 
+class LoadProgress;
+
 /** * @class Texture
  * @brief Class for handling OpenGL textures.
  * This class provides methods to load textures from files, bind them for rendering,
@@ -42,6 +47,86 @@ public:
      */
     bool LoadFromFile(const std::string &path);
 
+    /**
+     * @brief Decodes an image file into CPU staging memory without touching OpenGL.
+     * The staging memory holds the full mipmap chain, which is built right after decoding.
+     * With compression enabled, opaque images are stored as BC1. The chain is cached in the derived-asset cache.
+     * Safe to call from a worker thread; call Upload() on the GL thread afterwards.
+     * The file is streamed into the decoder, which stops reading once a stop is requested.
+     * @param path The path to the texture file.
+     * @param stop Token that cancels the decode.
+     * @param progress Advanced by the number of file bytes read, if not null.
+     * @return True if the image was decoded successfully, false otherwise or if cancelled.
+     */
+    bool Decode(const std::string &path, std::stop_token stop = {}, LoadProgress *progress = nullptr);
+
+    /**
+     * @brief Uploads the decoded mipmap chain to a new OpenGL texture and frees the staging memory.
+     * Must be called on the thread that owns the OpenGL context.
+     * @return True if the texture was uploaded successfully, false otherwise.
+     */
+    bool Upload();
+
+    /**
+     * @brief Checks whether a decoded image is waiting for Upload() or the TextureUploader.
+     * @return True if staging memory holds an image that has not been uploaded yet.
+     */
+    bool HasPendingUpload() const { return staging != nullptr; }
+
+    /**
+     * @brief Resizes the decoded staging image with bilinear filtering and rebuilds its mipmap chain.
+     * Used to bring images to the common layer size of a texture array. BC1 images stay BC1.
+     * @param newWidth The new width in pixels.
+     * @param newHeight The new height in pixels.
+     * @return True if the staging image now has the requested size.
+     */
+    bool Resample(int newWidth, int newHeight);
+
+    /**
+     * @brief Frees the decoded staging image without uploading it.
+     */
+    void FreeStaging();
+
+    /**
+     * @brief Gets the decoded mipmap chain, laid out as by LevelOffset(), or null if nothing is staged.
+     */
+    const unsigned char *GetStaging() const { return staging; }
+
+    /**
+     * @brief Gets the path of the file the texture was decoded from.
+     */
+    const std::string &GetSourcePath() const { return sourcePath; }
+
+    /**
+     * @brief Sets trilinear filtering and the mipmap range on the texture bound to a target.
+     * Shared by every path that creates a mipmapped texture, so they all sample the same way.
+     * @param target GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY.
+     * @param levelCount Number of mipmap levels the texture has.
+     */
+    static void SetMipmapSampling(GLenum target, int levelCount);
+
+    /**
+     * @brief Enables BC1 compression of opaque images for all later decodes.
+     * Call once the OpenGL extensions are known; only enable it with EXT_texture_compression_s3tc.
+     */
+    static void SetCompression(bool enabled);
+
+    /**
+     * @brief Checks whether an OpenGL internal format is block compressed.
+     */
+    static bool IsCompressedFormat(GLenum format);
+
+    /**
+     * @brief Gets the byte offset of a mipmap level within a staging chain.
+     * LevelOffset(format, width, height, levelCount) is the size of the whole chain.
+     */
+    static size_t LevelOffset(GLenum format, int width, int height, int level);
+
+    /**
+     * @brief Gets the OpenGL internal format of the staging chain.
+     */
+    GLenum GetFormat() const { return format; }
+
     /**
      * @brief Binds the texture for rendering.
      * This method binds the texture to the current OpenGL context so it can be used in rendering.
@@ -73,12 +158,27 @@ public:
     void Release();
 
 private:
+    friend class TextureUploader;
+
+    bool LoadBlob(uint64_t key, const std::string &path, uint64_t sourceSize, std::stop_token stop,
+                  LoadProgress *progress);
+
+    bool IsOpaque(int channels) const;
+
+    void Compress();
+
+    static std::atomic<bool> compressionEnabled;
+
     /**
      * @brief The OpenGL texture ID.
      * This ID is generated by OpenGL when the texture is loaded.
      */
     GLuint id = 0;
     int width = 0, height = 0;
+    int levelCount = 0;                  // Mipmap levels in the staging chain
+    GLenum format = GL_RGBA8;            // GL_RGBA8 or GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    std::string sourcePath;              // File the staging image was decoded from, for log messages
+    unsigned char *staging = nullptr;    // Mipmap chain in format (see LevelOffset), owned until Upload()
 };
 
 #endif //BILLIARDSHOW_TEXTURE_H
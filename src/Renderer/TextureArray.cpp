@@ -0,0 +1,110 @@
+/**
+ * @file TextureArray.cpp
+ * @brief Implementation of the TextureArray class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "TextureArray.h"
+#include "Texture.h"
+#include "TextureUploader.h"
+#include "MipChain.h"
+#include "../Utils/Logger.h"
+
+#include <string>
+
+TextureArray::TextureArray() {}
+
+TextureArray::~TextureArray() {
+    if (id) Release();
+}
+
+/**
+ * @fn Allocate
+ * @brief Creates uninitialized storage for all layers and mipmap levels, with the same sampling state as Texture.
+ */
+bool TextureArray::Allocate(int width, int height, int layerCount, GLenum format) {
+    if (id) Release();
+    if (width <= 0 || height <= 0 || layerCount <= 0) {
+        Logger::Error("Invalid texture array size: " + std::to_string(width) + "x" + std::to_string(height) + "x" +
+                      std::to_string(layerCount));
+        return false;
+    }
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+    const int levels = MipChain::LevelCount(width, height);
+    Texture::SetMipmapSampling(GL_TEXTURE_2D_ARRAY, levels);
+    for (int level = 0; level < levels; ++level) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, (GLint) format, MipChain::LevelSize(width, level),
+                     MipChain::LevelSize(height, level), layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    GLenum err = glGetError();
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    if (err != GL_NO_ERROR || id == 0) {
+        Logger::Error("OpenGL error while allocating texture array: " + std::to_string(err));
+        if (id) glDeleteTextures(1, &id);
+        id = 0;
+        return false;
+    }
+    this->width = width;
+    this->height = height;
+    this->layerCount = layerCount;
+    this->format = format;
+    ready.assign(layerCount, false);
+    Logger::Info("Allocated texture array: " + std::to_string(width) + "x" + std::to_string(height) + "x" +
+                 std::to_string(layerCount));
+    return true;
+}
+
+/**
+ * @fn UploadLayer
+ * @brief Uploads every mipmap level of one layer with glTexSubImage3D.
+ */
+bool TextureArray::UploadLayer(int layer, const unsigned char *chain) {
+    if (!id || layer < 0 || layer >= layerCount || !chain) return false;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+    for (int level = 0; level < MipChain::LevelCount(width, height); ++level) {
+        const int w = MipChain::LevelSize(width, level);
+        const int h = MipChain::LevelSize(height, level);
+        const size_t offset = Texture::LevelOffset(format, width, height, level);
+        if (Texture::IsCompressedFormat(format))
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, w, h, 1, format,
+                                      (GLsizei) (Texture::LevelOffset(format, width, height, level + 1) - offset),
+                                      chain + offset);
+        else
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                            chain + offset);
+    }
+    GLenum err = glGetError();
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    if (err != GL_NO_ERROR) {
+        Logger::Error("OpenGL error while uploading texture array layer " + std::to_string(layer) + ": " +
+                      std::to_string(err));
+        return false;
+    }
+    ready[layer] = true;
+    return true;
+}
+
+/**
+ * @fn Bind
+ * @brief Binds the array to a texture unit.
+ */
+void TextureArray::Bind(unsigned int unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * @fn Release
+ * @brief Deletes the array and abandons pending layer uploads.
+ */
+void TextureArray::Release() {
+    TextureUploader::Instance().Cancel(this);
+    if (id) glDeleteTextures(1, &id);
+    id = 0;
+    width = height = layerCount = 0;
+    format = GL_RGBA8;
+    ready.clear();
+}
@@ -0,0 +1,90 @@
+/**
+ * @file TextureArray.h
+ * @brief Header file for the TextureArray class.
+ * A GL_TEXTURE_2D_ARRAY whose layers hold same-sized images, so many models can share one texture binding.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_TEXTUREARRAY_H
+#define BILLIARDSHOW_TEXTUREARRAY_H
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/**
+ * @class TextureArray
+ * @brief Owns a mipmapped 2D texture array with RGBA8 or BC1 layers.
+ * Layers are filled one by one, either synchronously with UploadLayer() or streamed by the
+ * TextureUploader; a layer only counts as ready once its pixels have reached the GPU.
+ * All methods except the getters must be called on the thread that owns the OpenGL context.
+ */
+class TextureArray {
+public:
+    TextureArray();
+
+    ~TextureArray();
+
+    TextureArray(const TextureArray &) = delete;
+
+    TextureArray &operator=(const TextureArray &) = delete;
+
+    /**
+     * @brief Creates the array storage, replacing any previous one.
+     * @param width Width of every layer in pixels.
+     * @param height Height of every layer in pixels.
+     * @param layerCount Number of layers.
+     * @param format Internal format of the layers: GL_RGBA8 or a compressed format, see Texture::IsCompressedFormat.
+     * @return True if the storage was created.
+     */
+    bool Allocate(int width, int height, int layerCount, GLenum format = GL_RGBA8);
+
+    /**
+     * @brief Uploads the pixels of one layer synchronously.
+     * @param layer The layer index.
+     * @param chain Mipmap chain in the array's format and size, laid out as by Texture::LevelOffset.
+     * @return True if the layer was uploaded.
+     */
+    bool UploadLayer(int layer, const unsigned char *chain);
+
+    /**
+     * @brief Binds the array to a texture unit and makes unit 0 active again.
+     * @param unit Texture unit index (0 for GL_TEXTURE0).
+     */
+    void Bind(unsigned int unit) const;
+
+    /**
+     * @brief Checks whether a layer's pixels have been uploaded.
+     */
+    bool IsLayerReady(int layer) const { return layer >= 0 && layer < layerCount && ready[layer]; }
+
+    bool IsValid() const { return id != 0; }
+
+    int GetWidth() const { return width; }
+
+    int GetHeight() const { return height; }
+
+    int GetLayerCount() const { return layerCount; }
+
+    GLenum GetFormat() const { return format; }
+
+    /**
+     * @brief Deletes the array and abandons pending layer uploads.
+     */
+    void Release();
+
+private:
+    friend class TextureUploader;
+
+    void MarkLayerReady(int layer) { ready[layer] = true; }
+
+    GLuint id = 0;
+    int width = 0, height = 0, layerCount = 0;
+    GLenum format = GL_RGBA8;
+    std::vector<bool> ready; // Per layer: pixels have reached the GPU
+};
+
+#endif //BILLIARDSHOW_TEXTUREARRAY_H
@@ -0,0 +1,73 @@
+/**
+ * @file TextureBlob.cpp
+ * @brief Implementation of the TextureBlob class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "TextureBlob.h"
+#include "../Utils/DerivedCache.h"
+#include "../Utils/Logger.h"
+
+#include <cstring>
+
+/**
+ * @fn KeyFor
+ * @brief Derives the cache key from the image contents, the compression setting and the blob format version.
+ */
+uint64_t TextureBlob::KeyFor(uint64_t sourceHash, bool compression) {
+    return DerivedCache::Key("texture", VERSION, {sourceHash, compression ? 1u : 0u});
+}
+
+/**
+ * @fn Write
+ * @brief Writes a mipmap chain into a blob in the derived-asset cache.
+ * Layout: header, then the levels back to back starting on a 16-byte boundary.
+ */
+bool TextureBlob::Write(uint64_t key, uint32_t format, int width, int height, int levelCount,
+                        const unsigned char *data, uint64_t dataSize) {
+    Header h = {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.format = format;
+    h.width = static_cast<uint32_t>(width);
+    h.height = static_cast<uint32_t>(height);
+    h.levelCount = static_cast<uint32_t>(levelCount);
+    h.dataOffset = static_cast<uint32_t>((sizeof(Header) + 15) & ~size_t(15));
+    h.dataSize = dataSize;
+
+    const std::byte padding[16] = {};
+    if (!DerivedCache::Instance().Store(key, "texture", {
+            std::as_bytes(std::span(&h, 1)),
+            std::span(padding, h.dataOffset - sizeof(h)),
+            std::as_bytes(std::span(data, dataSize))}))
+        return false;
+    Logger::Info("Compiled texture blob: " + DerivedCache::Instance().PathFor(key, "texture"));
+    return true;
+}
+
+/**
+ * @fn Open
+ * @brief Maps a blob and validates its header against the mapped size.
+ */
+bool TextureBlob::Open(uint64_t key) {
+    header = nullptr;
+    if (!DerivedCache::Instance().Open(key, "texture", file)) return false;
+    path = DerivedCache::Instance().PathFor(key, "texture");
+    if (file.Size() < sizeof(Header)) return false;
+    const auto *h = reinterpret_cast<const Header *>(file.Data());
+    if (h->magic != MAGIC || h->version != VERSION) {
+        Logger::Warn("Ignoring texture blob with unknown format: " + path);
+        return false;
+    }
+    if (h->width == 0 || h->height == 0 || h->levelCount == 0 || h->dataOffset + h->dataSize > file.Size()) {
+        Logger::Warn("Ignoring truncated texture blob: " + path);
+        return false;
+    }
+    header = h;
+    return true;
+}
+
+const unsigned char *TextureBlob::Data() const {
+    return reinterpret_cast<const unsigned char *>(file.Data() + header->dataOffset);
+}
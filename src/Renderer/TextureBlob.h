@@ -0,0 +1,81 @@
+/**
+ * @file TextureBlob.h
+ * @brief Header file for the TextureBlob class.
+ * A texture blob caches the decoded mipmap chain of an image file, RGBA8 or block-compressed:
+ * a fixed header followed by the levels. Blobs are stored in the derived-asset cache under a key
+ * of the image file's contents the first time the image is decoded, and later runs copy the
+ * chain straight out of the mapping without decoding the image again.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_TEXTUREBLOB_H
+#define BILLIARDSHOW_TEXTUREBLOB_H
+
+#pragma once
+
+#include "../Utils/MappedFile.h"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class TextureBlob
+ * @brief Reads and writes cached texture chains.
+ * Like mesh blobs, the key covers the whole source file, so an edited image misses and is decoded again.
+ */
+class TextureBlob {
+public:
+    static constexpr uint32_t MAGIC = 0x42545342; // "BSTB" in little-endian byte order
+    static constexpr uint32_t VERSION = 2;
+
+    /**
+     * @struct Header
+     * @brief On-disk header; the data offset is in bytes from the start of the blob.
+     */
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;      // OpenGL internal format of the levels
+        uint32_t width;       // Size of level 0 in pixels
+        uint32_t height;
+        uint32_t levelCount;
+        uint32_t dataOffset;
+        uint32_t reserved;
+        uint64_t dataSize;    // Bytes of all levels together
+    };
+
+    /**
+     * @brief Gets the cache key of the blob decoded from an image file.
+     * @param sourceHash XXH64 of the whole image file.
+     * @param compression Whether compression was enabled, which decides the format of opaque images.
+     */
+    static uint64_t KeyFor(uint64_t sourceHash, bool compression);
+
+    /**
+     * @brief Writes a mipmap chain into a blob in the derived-asset cache.
+     * @param key The key from KeyFor().
+     * @return True if the blob was written.
+     */
+    static bool Write(uint64_t key, uint32_t format, int width, int height, int levelCount,
+                      const unsigned char *data, uint64_t dataSize);
+
+    /**
+     * @brief Maps a blob from the derived-asset cache and validates its header.
+     * @return False if the blob is missing, truncated, or from another format version.
+     */
+    bool Open(uint64_t key);
+
+    const std::string &GetPath() const { return path; }
+
+    const Header &GetHeader() const { return *header; }
+
+    const unsigned char *Data() const;
+
+private:
+    MappedFile file;
+    std::string path;
+    const Header *header = nullptr;
+};
+
+#endif //BILLIARDSHOW_TEXTUREBLOB_H
@@ -0,0 +1,225 @@
+/**
+ * @file TextureUploader.cpp
+ * @brief Implementation of the TextureUploader class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "TextureUploader.h"
+#include "Texture.h"
+#include "TextureArray.h"
+#include "MipChain.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+TextureUploader &TextureUploader::Instance() {
+    static TextureUploader instance;
+    return instance;
+}
+
+/**
+ * @fn StreamingSupported
+ * @brief Checks for pixel buffer objects (GL 2.1) and fence syncs (GL 3.2 or ARB_sync).
+ */
+bool TextureUploader::StreamingSupported() const {
+    return (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) && (GLEW_VERSION_3_2 || GLEW_ARB_sync);
+}
+
+/**
+ * @fn Enqueue
+ * @brief Queues a texture whose decoded staging image should be uploaded.
+ */
+void TextureUploader::Enqueue(Texture *texture) {
+    EnqueueLayer(texture, nullptr, 0);
+}
+
+/**
+ * @fn EnqueueLayer
+ * @brief Queues a texture whose decoded staging image should be uploaded into a texture array layer.
+ * A texture can only be queued once, whatever its destination.
+ */
+void TextureUploader::EnqueueLayer(Texture *texture, TextureArray *array, int layer) {
+    if (!texture || !texture->HasPendingUpload()) return;
+    for (const auto &request: queue)
+        if (request.texture == texture) return;
+    queue.push_back({texture, array, layer});
+}
+
+/**
+ * @fn Pump
+ * @brief Publishes finished uploads and starts new ones within the byte budget.
+ * Fences are polled with a zero timeout, so this never blocks on the GPU. An upload whose fence
+ * cannot be waited on is dropped rather than published.
+ */
+void TextureUploader::Pump(size_t byteBudget) {
+    for (auto it = inFlight.begin(); it != inFlight.end();) {
+        GLenum status = glClientWaitSync(it->fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            ++it;
+            continue;
+        }
+        const Request &request = it->request;
+        glDeleteSync(it->fence);
+        glDeleteBuffers(1, &it->pbo);
+        if (status == GL_WAIT_FAILED) {
+            // The copy is not known to have finished, so nothing is published; the staging image is
+            // already gone, so the texture stays unloaded (a layer keeps drawing the plain color)
+            Logger::Error("Fence wait failed, dropping texture upload: " + request.texture->sourcePath);
+            if (it->textureId) glDeleteTextures(1, &it->textureId);
+            it = inFlight.erase(it);
+            continue;
+        }
+        if (request.array) request.array->MarkLayerReady(request.layer);
+        else request.texture->id = it->textureId;
+        Logger::Info("Texture streamed to GPU: " + request.texture->sourcePath);
+        it = inFlight.erase(it);
+    }
+
+    size_t spent = 0;
+    while (!queue.empty()) {
+        Request request = queue.front();
+        const Texture *texture = request.texture;
+        size_t bytes = Texture::LevelOffset(texture->format, texture->width, texture->height, texture->levelCount);
+        if (spent > 0 && spent + bytes > byteBudget) break;
+        queue.pop_front();
+        if (!request.texture->HasPendingUpload()) continue;
+        if (Start(request)) spent += bytes;
+    }
+    // Make sure the new uploads and their fences reach the GPU without waiting for the buffer swap
+    if (spent > 0) glFlush();
+}
+
+/**
+ * @fn UploadNow
+ * @brief Uploads a request synchronously from the staging memory, which is freed afterwards.
+ */
+void TextureUploader::UploadNow(const Request &request) {
+    if (!request.array) {
+        request.texture->Upload();
+        return;
+    }
+    if (!request.array->UploadLayer(request.layer, request.texture->staging))
+        Logger::Error("Failed to upload texture array layer: " + request.texture->sourcePath);
+    request.texture->FreeStaging();
+}
+
+/**
+ * @fn Start
+ * @brief Copies a texture's staging image into a fresh PBO and issues the upload from it.
+ * The staging memory is freed as soon as it has been copied. Without streaming support, or if the
+ * PBO cannot be mapped, the texture is uploaded synchronously instead.
+ * @return True if the texture's pixels were consumed (streamed or uploaded), so they count against the budget.
+ */
+bool TextureUploader::Start(const Request &request) {
+    Texture *texture = request.texture;
+    TextureArray *array = request.array;
+    if (array && (!array->IsValid() || texture->width != array->GetWidth() || texture->height != array->GetHeight() ||
+                  texture->format != array->GetFormat() || request.layer < 0 ||
+                  request.layer >= array->GetLayerCount())) {
+        Logger::Error("Texture does not fit its texture array layer: " + texture->sourcePath);
+        texture->FreeStaging();
+        return false;
+    }
+    if (!StreamingSupported()) {
+        UploadNow(request);
+        return true;
+    }
+    const size_t bytes = Texture::LevelOffset(texture->format, texture->width, texture->height, texture->levelCount);
+    Upload upload{request, 0, 0, nullptr};
+    glGenBuffers(1, &upload.pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) bytes, nullptr, GL_STREAM_DRAW);
+    void *dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) bytes,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!dst) {
+        Logger::Warn("Could not map PBO, uploading synchronously: " + texture->sourcePath);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &upload.pbo);
+        UploadNow(request);
+        return true;
+    }
+    std::memcpy(dst, texture->staging, bytes);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    texture->FreeStaging();
+
+    // With a PBO bound, the data pointer is an offset into the buffer; every mipmap level comes from the same PBO
+    if (array) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array->id);
+    } else {
+        glGenTextures(1, &upload.textureId);
+        glBindTexture(GL_TEXTURE_2D, upload.textureId);
+        Texture::SetMipmapSampling(GL_TEXTURE_2D, texture->levelCount);
+    }
+    const GLenum format = texture->format;
+    const bool compressed = Texture::IsCompressedFormat(format);
+    for (int level = 0; level < texture->levelCount; ++level) {
+        const int w = MipChain::LevelSize(texture->width, level);
+        const int h = MipChain::LevelSize(texture->height, level);
+        const size_t start = Texture::LevelOffset(format, texture->width, texture->height, level);
+        const auto size = (GLsizei) (Texture::LevelOffset(format, texture->width, texture->height, level + 1) - start);
+        auto *offset = (void *) start;
+        if (array && compressed)
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, request.layer, w, h, 1, format, size, offset);
+        else if (array)
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, request.layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                            offset);
+        else if (compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, format, w, h, 0, size, offset);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, offset);
+    }
+    glBindTexture(array ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        Logger::Error("OpenGL error while streaming texture: " + std::to_string(err) + ", path: " +
+                      texture->sourcePath);
+        if (upload.textureId) glDeleteTextures(1, &upload.textureId);
+        glDeleteBuffers(1, &upload.pbo);
+        return false;
+    }
+    upload.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    inFlight.push_back(upload);
+    return true;
+}
+
+/**
+ * @fn Cancel
+ * @brief Removes a texture from the queue and abandons its upload if one is in flight.
+ */
+void TextureUploader::Cancel(Texture *texture) {
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+                               [texture](const Request &request) { return request.texture == texture; }),
+                queue.end());
+    for (auto it = inFlight.begin(); it != inFlight.end();) {
+        if (it->request.texture == texture) {
+            glDeleteSync(it->fence);
+            glDeleteBuffers(1, &it->pbo);
+            if (it->textureId) glDeleteTextures(1, &it->textureId);
+            it = inFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @fn Cancel
+ * @brief Removes all layer uploads into an array from the queue and abandons those in flight.
+ */
+void TextureUploader::Cancel(TextureArray *array) {
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+                               [array](const Request &request) { return request.array == array; }),
+                queue.end());
+    for (auto it = inFlight.begin(); it != inFlight.end();) {
+        if (it->request.array == array) {
+            glDeleteSync(it->fence);
+            glDeleteBuffers(1, &it->pbo);
+            it = inFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file TextureUploader.h
+ * @brief Header file for the TextureUploader class.
+ * Streams decoded textures to the GPU through pixel buffer objects (PBOs), a few per frame,
+ * and publishes each texture (or texture array layer) only after a fence sync reports its upload as finished.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_TEXTUREUPLOADER_H
+#define BILLIARDSHOW_TEXTUREUPLOADER_H
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+class Texture;
+
+class TextureArray;
+
+/**
+ * @class TextureUploader
+ * @brief Asynchronous texture upload queue for the GL thread.
+ * Worker threads decode images into Texture staging memory; the GL thread enqueues those textures
+ * and calls Pump() once per frame. Pump() copies at most a byte budget of pixels into PBOs, issues
+ * glTexImage2D for every mipmap level from them and inserts a fence. A texture becomes valid once its fence has signalled,
+ * so rendering never waits on an upload. Without PBO or sync object support, uploads fall back to
+ * a plain synchronous glTexImage2D.
+ */
+class TextureUploader {
+public:
+    // Default number of pixel bytes copied into PBOs per frame (one 2048x1024 RGBA8 ball texture and its mipmaps)
+    static constexpr size_t DEFAULT_BYTES_PER_FRAME = 11u * 1024u * 1024u;
+
+    /**
+     * @brief Gets the process-wide uploader.
+     */
+    static TextureUploader &Instance();
+
+    /**
+     * @brief Queues a texture whose decoded staging image should be uploaded.
+     * Must be called on the GL thread.
+     * @param texture The texture; it must stay alive until uploaded or cancelled.
+     */
+    void Enqueue(Texture *texture);
+
+    /**
+     * @brief Queues a texture whose decoded staging image should be uploaded into a layer of a texture array.
+     * The image must have the array's size. The layer is marked ready once its upload has finished;
+     * the texture itself gets no OpenGL texture of its own.
+     * Must be called on the GL thread.
+     * @param texture The texture; it must stay alive until uploaded or cancelled.
+     * @param array The destination array; it must stay alive until uploaded or cancelled.
+     * @param layer The destination layer.
+     */
+    void EnqueueLayer(Texture *texture, TextureArray *array, int layer);
+
+    /**
+     * @brief Publishes finished uploads and starts new ones within the byte budget.
+     * Must be called on the GL thread, typically once at the top of every frame.
+     * At least one upload is started per call even if it is larger than the budget.
+     * @param byteBudget Maximum number of pixel bytes to start uploading in this call.
+     */
+    void Pump(size_t byteBudget = DEFAULT_BYTES_PER_FRAME);
+
+    /**
+     * @brief Removes a texture from the queue and abandons its upload if one is in flight.
+     * Called by Texture when it is destroyed or released.
+     */
+    void Cancel(Texture *texture);
+
+    /**
+     * @brief Removes all layer uploads into an array from the queue and abandons those in flight.
+     * Called by TextureArray when it is destroyed or released.
+     */
+    void Cancel(TextureArray *array);
+
+    /**
+     * @brief Checks whether there is no queued or in-flight upload.
+     */
+    bool IsIdle() const { return queue.empty() && inFlight.empty(); }
+
+private:
+    TextureUploader() = default;
+
+    struct Request {
+        Texture *texture;
+        TextureArray *array; // Null for a standalone texture
+        int layer;
+    };
+
+    struct Upload {
+        Request request;
+        GLuint textureId; // Standalone textures only
+        GLuint pbo;
+        GLsync fence;
+    };
+
+    bool StreamingSupported() const;
+
+    bool Start(const Request &request);
+
+    void UploadNow(const Request &request);
+
+    std::deque<Request> queue;
+    std::vector<Upload> inFlight;
+};
+
+#endif //BILLIARDSHOW_TEXTUREUPLOADER_H
@@ -15,6 +15,7 @@
 #include "../Utils/Logger.h"
 #include "../App.h"
 #include "../Scene/Table.h"
+#include "BallSystem.h"
 
 // Forward declarations
 class Renderer;
@@ -23,14 +24,22 @@ class Table;
 
 /**
  * @class Ball
- * @brief Represents a billiard ball with properties and methods for rendering and physics interactions.
+ * @brief Represents a billiard ball with its number, model and physics state.
+ * The physics state lives in a BallSystem; a Ball is a handle to its entry there plus the ball's
+ * number and model. The system steps all balls together.
  */
 class Ball {
 public:
     // Constants
     static constexpr float RADIUS = Constants::BALL_RADIUS; // 2.8575 cm in meters
 
-    Ball(int number, const glm::vec3 &position);
+    /**
+     * @brief Adds a ball to a ball system.
+     * @param system The system holding the ball's state; it must outlive the ball.
+     * @param number The ball number.
+     * @param position Initial position of the ball.
+     */
+    Ball(BallSystem &system, int number, const glm::vec3 &position);
 
     ~Ball();
 
@@ -58,12 +67,19 @@ public:
      */
     void SetModel(ObjectLoader *model);
 
+    /**
+     * @brief Gets the model of the ball.
+     * @return Pointer to the ObjectLoader, or nullptr if the ball has no model.
+     */
+    ObjectLoader *GetModel() const { return model; }
+
     /**
      * @brief Renders the ball using the provided renderer.
      * @param renderer Pointer to the Renderer instance used for rendering.
      * @param scale Scale factor for rendering the ball.
+     * @param alpha How far between the last two physics steps to draw the ball, see BallSystem::GetPosition.
      */
-    void Render(Renderer *renderer, float scale);
+    void Render(Renderer *renderer, float scale, float alpha = 1.0f);
 
     /**
      * @brief Sets the velocity of the ball.
@@ -81,51 +97,24 @@ public:
      * @brief Sets the angular velocity of the ball.
      * @param avel The new angular velocity of the ball as a glm::vec3.
      */
-    void SetAngularVelocity(const glm::vec3 &avel) { angularVelocity = avel; }
+    void SetAngularVelocity(const glm::vec3 &avel) { system->SetAngularVelocity(index, avel); }
 
     /**
-     * @brief Sets the rotation of the ball.
-     * @param rot The new rotation matrix of the ball as a glm::mat4.
+     * @brief Gets the angular velocity of the ball.
+     * @return The angular velocity of the ball in radians per second.
      */
-    glm::vec3 GetAngularVelocity() const { return angularVelocity; }
+    glm::vec3 GetAngularVelocity() const { return system->GetAngularVelocity(index); }
 
     /**
      * @brief Gets the rotation matrix of the ball.
      * @return The rotation matrix of the ball as a glm::mat4.
      */
-    glm::mat4 GetRotation() const { return rotation; }
+    glm::mat4 GetRotation() const { return system->GetRotation(index); }
 
     /**
-     * @brief Updates the ball's position and rotation based on its velocity and angular velocity.
-     * @param deltaTime The time elapsed since the last update in seconds.
+     * @brief Gets the index of the ball in its BallSystem.
      */
-    void Update(float deltaTime);
-
-    /**
-     * @brief Applies friction to the ball's velocity.
-     * @param deltaTime The time elapsed since the last update in seconds.
-     * @param friction The friction coefficient to apply.
-     */
-    void ApplyFriction(float deltaTime, float friction);
-
-    /**
-     * @brief Applies rolling friction to the ball's velocity.
-     * @param deltaTime The time elapsed since the last update in seconds.
-     * @param rollingFriction The rolling friction coefficient to apply.
-     */
-    void ApplyRollingFriction(float deltaTime, float rollingFriction);
-
-    /**
-     * @brief Resolves collision with the table.
-     * @param table The Table instance representing the billiard table.
-     */
-    void ResolveTableCollision(const Table &table);
-
-    /**
-     * @brief Resolves collision with another ball.
-     * @param other The other Ball instance to resolve collision with.
-     */
-    void ResolveBallCollision(Ball &other);
+    int GetIndex() const { return index; }
 
     /**
      * @brief Installs the ball model for rendering.
@@ -134,15 +123,9 @@ public:
     void Install();
 
 private:
-    /**
-     * @brief Updates the rotation matrix based on the angular velocity.
-     * @param deltaTime The time elapsed since the last update in seconds.
-     */
+    BallSystem *system; // Holds position, velocity, spin and orientation
+    int index; // Entry in system
     int number;
-    glm::vec3 position;
-    glm::vec3 velocity = glm::vec3(0.0f, 0.0f, 0.0f); // Initial velocity
-    glm::vec3 angularVelocity = glm::vec3(0.0f); // radians/sec
-    glm::mat4 rotation = glm::mat4(0.0f); // orientation
     ObjectLoader *model;
 };
 
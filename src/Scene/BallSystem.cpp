@@ -0,0 +1,737 @@
+/**
+ * @file BallSystem.cpp
+ * @brief Implementation of the BallSystem class.
+ * The integration and cushion kernels are written once against a small lane interface and
+ * instantiated for scalar floats, SSE2 and AVX2. They use no fused multiply-adds and no
+ * approximate reciprocals, so every width computes bit-identical results.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "BallSystem.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define BALLSYSTEM_X86 1
+#include <immintrin.h>
+#endif
+
+// Forces the kernel template into the function that instantiates it, so the AVX2 instantiation
+// is compiled with that function's AVX2 target while the SSE2 one keeps the baseline target.
+#if defined(__GNUC__) || defined(__clang__)
+#define BALLSYSTEM_INLINE inline __attribute__((always_inline))
+#else
+#define BALLSYSTEM_INLINE inline
+#endif
+
+static constexpr float RADIUS = Constants::BALL_RADIUS;
+static constexpr float GRAVITY = 9.81f;        // m/s^2, downwards
+static constexpr float MIN_SPEED = 0.0001f;    // Below this a ball counts as still, m/s or rad/s
+static constexpr float SPIN_THRESHOLD = 0.2f;  // Flat speed above which the spin locks to rolling, m/s
+static constexpr float TWO_PI = 6.28318530717958647692f;
+// Range of ball centres inside the cushions, and the height of a ball resting on the cloth
+static constexpr float MIN_X = -Constants::PLAY_LENGTH / 2.0f + RADIUS;
+static constexpr float MAX_X = Constants::PLAY_LENGTH / 2.0f - RADIUS;
+static constexpr float MIN_Z = -Constants::PLAY_WIDTH / 2.0f + RADIUS;
+static constexpr float MAX_Z = Constants::PLAY_WIDTH / 2.0f - RADIUS;
+static constexpr float SURFACE_Y = Constants::OUTER_HEIGHT / 2.0f + RADIUS;
+// Most contacts Step() resolves in time order per step; any left over are fixed up as overlaps
+static constexpr int MAX_CONTACTS_PER_STEP = 64;
+// Broadphase cells are one ball diameter wide, so touching balls are always in the same or adjacent cells
+static constexpr float CELL_SIZE = 2.0f * RADIUS;
+static constexpr int GRID_X = (int) (Constants::PLAY_LENGTH / CELL_SIZE) + 1;
+static constexpr int GRID_Z = (int) (Constants::PLAY_WIDTH / CELL_SIZE) + 1;
+
+/**
+ * @struct ScalarLanes
+ * @brief One ball at a time; masks are plain booleans.
+ */
+struct ScalarLanes {
+    using F = float;
+    using M = bool;
+    static constexpr int WIDTH = 1;
+
+    static F Load(const float *p) { return *p; }
+
+    static void Store(float *p, F a) { *p = a; }
+
+    static F Set(float a) { return a; }
+
+    static F Add(F a, F b) { return a + b; }
+
+    static F Sub(F a, F b) { return a - b; }
+
+    static F Mul(F a, F b) { return a * b; }
+
+    static F Div(F a, F b) { return a / b; }
+
+    static F Sqrt(F a) { return std::sqrt(a); }
+
+    static F Min(F a, F b) { return b < a ? b : a; }
+
+    static F Max(F a, F b) { return a < b ? b : a; }
+
+    static F Round(F a) { return std::nearbyint(a); }
+
+    static M Less(F a, F b) { return a < b; }
+
+    static M Greater(F a, F b) { return a > b; }
+
+    static M And(M a, M b) { return a && b; }
+
+    static F Select(M m, F a, F b) { return m ? a : b; }
+};
+
+#ifdef BALLSYSTEM_X86
+
+/**
+ * @struct SSE2Lanes
+ * @brief Four balls at a time; masks are all-ones or all-zeros lanes.
+ */
+struct SSE2Lanes {
+    using F = __m128;
+    using M = __m128;
+    static constexpr int WIDTH = 4;
+
+    static F Load(const float *p) { return _mm_load_ps(p); }
+
+    static void Store(float *p, F a) { _mm_store_ps(p, a); }
+
+    static F Set(float a) { return _mm_set1_ps(a); }
+
+    static F Add(F a, F b) { return _mm_add_ps(a, b); }
+
+    static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+
+    static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+
+    static F Div(F a, F b) { return _mm_div_ps(a, b); }
+
+    static F Sqrt(F a) { return _mm_sqrt_ps(a); }
+
+    static F Min(F a, F b) { return _mm_min_ps(a, b); }
+
+    static F Max(F a, F b) { return _mm_max_ps(a, b); }
+
+    static F Round(F a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+
+    static M Less(F a, F b) { return _mm_cmplt_ps(a, b); }
+
+    static M Greater(F a, F b) { return _mm_cmpgt_ps(a, b); }
+
+    static M And(M a, M b) { return _mm_and_ps(a, b); }
+
+    static F Select(M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BALLSYSTEM_AVX2 1
+#define BALLSYSTEM_TARGET_AVX2 __attribute__((target("avx2")))
+// The kernel templates take 256-bit vectors but are always inlined, so no call passes one
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/**
+ * @struct AVX2Lanes
+ * @brief Eight balls at a time. Compiled for AVX2 regardless of the build flags.
+ */
+struct AVX2Lanes {
+    using F = __m256;
+    using M = __m256;
+    static constexpr int WIDTH = 8;
+
+    BALLSYSTEM_TARGET_AVX2 static F Load(const float *p) { return _mm256_load_ps(p); }
+
+    BALLSYSTEM_TARGET_AVX2 static void Store(float *p, F a) { _mm256_store_ps(p, a); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Set(float a) { return _mm256_set1_ps(a); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Div(F a, F b) { return _mm256_div_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Sqrt(F a) { return _mm256_sqrt_ps(a); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Min(F a, F b) { return _mm256_min_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Max(F a, F b) { return _mm256_max_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Round(F a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    BALLSYSTEM_TARGET_AVX2 static M Less(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+
+    BALLSYSTEM_TARGET_AVX2 static M Greater(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+
+    BALLSYSTEM_TARGET_AVX2 static M And(M a, M b) { return _mm256_and_ps(a, b); }
+
+    BALLSYSTEM_TARGET_AVX2 static F Select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+};
+#endif
+
+#endif
+
+/**
+ * @brief Sine and cosine of x: reduced to [-pi, pi], evaluated at x/4 where the Taylor
+ * polynomials are accurate to float precision, then doubled twice.
+ */
+template<typename L>
+BALLSYSTEM_INLINE static void sinCos(const typename L::F &angle, typename L::F &outSin, typename L::F &outCos) {
+    using F = typename L::F;
+    const F x = L::Sub(angle, L::Mul(L::Round(L::Mul(angle, L::Set(1.0f / TWO_PI))), L::Set(TWO_PI)));
+    const F q = L::Mul(x, L::Set(0.25f));
+    const F q2 = L::Mul(q, q);
+    F s = L::Add(L::Set(1.0f / 120.0f), L::Mul(q2, L::Set(-1.0f / 5040.0f)));
+    s = L::Add(L::Set(-1.0f / 6.0f), L::Mul(q2, s));
+    s = L::Mul(q, L::Add(L::Set(1.0f), L::Mul(q2, s)));
+    F c = L::Add(L::Set(-1.0f / 720.0f), L::Mul(q2, L::Set(1.0f / 40320.0f)));
+    c = L::Add(L::Set(1.0f / 24.0f), L::Mul(q2, c));
+    c = L::Add(L::Set(-0.5f), L::Mul(q2, c));
+    c = L::Add(L::Set(1.0f), L::Mul(q2, c));
+    for (int i = 0; i < 2; ++i) {
+        const F s2 = L::Mul(L::Set(2.0f), L::Mul(s, c));
+        c = L::Sub(L::Mul(c, c), L::Mul(s, s));
+        s = s2;
+    }
+    outSin = s;
+    outCos = c;
+}
+
+/**
+ * @brief Integration kernel for balls [begin, end) in steps of the lane width. Returns the first
+ * ball not processed. Per ball, in order:
+ * gravity and motion; spin locked to rolling above the spin threshold and cleared when still;
+ * orientation advanced by the spin; sliding friction, which also pulls the spin toward rolling
+ * and slows it; rolling friction.
+ * Positions move by the velocity times travel, which is dt, or 0 when Step() moves them itself.
+ * The arrays in a are in BallSystem's field order: position, velocity, angular velocity, quaternion.
+ */
+template<typename L>
+BALLSYSTEM_INLINE static int integrateLanes(float *const *a, int begin, int end, float dt, float travel,
+                                            float friction, float rollingFriction) {
+    using F = typename L::F;
+    using M = typename L::M;
+    const F zero = L::Set(0.0f);
+    const F one = L::Set(1.0f);
+    const F step = L::Set(dt);
+    const F move = L::Set(travel);
+    const F minSpeed = L::Set(MIN_SPEED);
+    const F invRadius = L::Set(1.0f / RADIUS);
+    const F tiny = L::Set(FLT_MIN); // Keeps zero-length divisions finite; the result is masked or zero anyway
+    int i = begin;
+    for (; i + L::WIDTH <= end; i += L::WIDTH) {
+        F px = L::Load(a[0] + i), py = L::Load(a[1] + i), pz = L::Load(a[2] + i);
+        F vx = L::Load(a[3] + i), vy = L::Load(a[4] + i), vz = L::Load(a[5] + i);
+        F wx = L::Load(a[6] + i), wy = L::Load(a[7] + i), wz = L::Load(a[8] + i);
+        F qx = L::Load(a[9] + i), qy = L::Load(a[10] + i), qz = L::Load(a[11] + i), qw = L::Load(a[12] + i);
+
+        // Gravity and motion
+        vy = L::Sub(vy, L::Set(GRAVITY * dt));
+        px = L::Add(px, L::Mul(vx, move));
+        py = L::Add(py, L::Mul(vy, move));
+        pz = L::Add(pz, L::Mul(vz, move));
+
+        // Rolling spin about cross(v_flat, up) = (-vz, 0, vx), at |v_flat| / RADIUS
+        F flat = L::Sqrt(L::Add(L::Mul(vx, vx), L::Mul(vz, vz)));
+        M moving = L::Greater(flat, minSpeed);
+        M slow = L::Less(flat, L::Set(SPIN_THRESHOLD));
+        wx = L::Select(moving, L::Select(slow, wx, L::Mul(L::Sub(zero, vz), invRadius)), zero);
+        wy = L::Select(L::And(moving, slow), wy, zero);
+        wz = L::Select(moving, L::Select(slow, wz, L::Mul(vx, invRadius)), zero);
+
+        // Orientation: q = q * (cos(angle / 2), sin(angle / 2) * axis), renormalized against drift
+        F spin = L::Sqrt(L::Add(L::Add(L::Mul(wx, wx), L::Mul(wy, wy)), L::Mul(wz, wz)));
+        M spinning = L::Greater(spin, minSpeed);
+        F sinHalf, cosHalf;
+        sinCos<L>(L::Mul(spin, L::Set(0.5f * dt)), sinHalf, cosHalf);
+        F k = L::Div(sinHalf, L::Max(spin, tiny));
+        F dx = L::Mul(wx, k), dy = L::Mul(wy, k), dz = L::Mul(wz, k);
+        F rx = L::Add(L::Add(L::Mul(qw, dx), L::Mul(qx, cosHalf)), L::Sub(L::Mul(qy, dz), L::Mul(qz, dy)));
+        F ry = L::Add(L::Sub(L::Mul(qw, dy), L::Mul(qx, dz)), L::Add(L::Mul(qy, cosHalf), L::Mul(qz, dx)));
+        F rz = L::Add(L::Sub(L::Mul(qw, dz), L::Mul(qy, dx)), L::Add(L::Mul(qx, dy), L::Mul(qz, cosHalf)));
+        F rw = L::Sub(L::Sub(L::Mul(qw, cosHalf), L::Mul(qx, dx)), L::Add(L::Mul(qy, dy), L::Mul(qz, dz)));
+        F norm = L::Sqrt(L::Add(L::Add(L::Mul(rx, rx), L::Mul(ry, ry)), L::Add(L::Mul(rz, rz), L::Mul(rw, rw))));
+        norm = L::Div(one, norm);
+        qx = L::Select(spinning, L::Mul(rx, norm), qx);
+        qy = L::Select(spinning, L::Mul(ry, norm), qy);
+        qz = L::Select(spinning, L::Mul(rz, norm), qz);
+        qw = L::Select(spinning, L::Mul(rw, norm), qw);
+
+        // Sliding friction
+        const F drop = L::Set(friction * dt);
+        F speed = L::Sqrt(L::Add(L::Add(L::Mul(vx, vx), L::Mul(vy, vy)), L::Mul(vz, vz)));
+        F scale = L::Div(L::Max(zero, L::Sub(speed, drop)), L::Max(speed, tiny));
+        vx = L::Mul(vx, scale);
+        vy = L::Mul(vy, scale);
+        vz = L::Mul(vz, scale);
+        // ... which also pulls the spin toward rolling, harder the faster the ball slides
+        flat = L::Sqrt(L::Add(L::Mul(vx, vx), L::Mul(vz, vz)));
+        moving = L::Greater(flat, minSpeed);
+        F blend = L::Mul(L::Mul(L::Min(L::Div(flat, L::Set(SPIN_THRESHOLD)), one), step), L::Set(2.0f));
+        F keep = L::Sub(one, blend);
+        wx = L::Select(moving, L::Add(L::Mul(wx, keep), L::Mul(L::Mul(L::Sub(zero, vz), invRadius), blend)), wx);
+        wy = L::Select(moving, L::Mul(wy, keep), wy);
+        wz = L::Select(moving, L::Add(L::Mul(wz, keep), L::Mul(L::Mul(vx, invRadius), blend)), wz);
+        // ... and slows the spin
+        spin = L::Sqrt(L::Add(L::Add(L::Mul(wx, wx), L::Mul(wy, wy)), L::Mul(wz, wz)));
+        scale = L::Div(L::Max(zero, L::Sub(spin, drop)), L::Max(spin, tiny));
+        wx = L::Mul(wx, scale);
+        wy = L::Mul(wy, scale);
+        wz = L::Mul(wz, scale);
+
+        // Rolling friction
+        speed = L::Sqrt(L::Add(L::Add(L::Mul(vx, vx), L::Mul(vy, vy)), L::Mul(vz, vz)));
+        scale = L::Div(L::Max(zero, L::Sub(speed, L::Set(rollingFriction * dt))), L::Max(speed, tiny));
+        vx = L::Mul(vx, scale);
+        vy = L::Mul(vy, scale);
+        vz = L::Mul(vz, scale);
+
+        L::Store(a[0] + i, px), L::Store(a[1] + i, py), L::Store(a[2] + i, pz);
+        L::Store(a[3] + i, vx), L::Store(a[4] + i, vy), L::Store(a[5] + i, vz);
+        L::Store(a[6] + i, wx), L::Store(a[7] + i, wy), L::Store(a[8] + i, wz);
+        L::Store(a[9] + i, qx), L::Store(a[10] + i, qy), L::Store(a[11] + i, qz), L::Store(a[12] + i, qw);
+    }
+    return i;
+}
+
+/**
+ * @brief Cushion and cloth kernel for balls [begin, end). Returns the first ball not processed.
+ * Clamps each ball into the play area, reflecting the velocity component into a cushion, puts it
+ * back on the cloth and sets its spin to match its new direction.
+ */
+template<typename L>
+BALLSYSTEM_INLINE static int tableLanes(float *const *a, int begin, int end) {
+    using F = typename L::F;
+    using M = typename L::M;
+    const F zero = L::Set(0.0f);
+    const F flip = L::Set(-1.0f);
+    const F minX = L::Set(MIN_X);
+    const F maxX = L::Set(MAX_X);
+    const F minZ = L::Set(MIN_Z);
+    const F maxZ = L::Set(MAX_Z);
+    const F surface = L::Set(SURFACE_Y);
+    const F invRadius = L::Set(1.0f / RADIUS);
+    int i = begin;
+    for (; i + L::WIDTH <= end; i += L::WIDTH) {
+        F px = L::Load(a[0] + i), py = L::Load(a[1] + i), pz = L::Load(a[2] + i);
+        F vx = L::Load(a[3] + i), vy = L::Load(a[4] + i), vz = L::Load(a[5] + i);
+
+        M hit = L::Less(px, minX);
+        px = L::Select(hit, minX, px);
+        vx = L::Select(hit, L::Mul(vx, flip), vx);
+        hit = L::Greater(px, maxX);
+        px = L::Select(hit, maxX, px);
+        vx = L::Select(hit, L::Mul(vx, flip), vx);
+        hit = L::Less(pz, minZ);
+        pz = L::Select(hit, minZ, pz);
+        vz = L::Select(hit, L::Mul(vz, flip), vz);
+        hit = L::Greater(pz, maxZ);
+        pz = L::Select(hit, maxZ, pz);
+        vz = L::Select(hit, L::Mul(vz, flip), vz);
+        // On the cloth, with no downward velocity
+        hit = L::Less(py, surface);
+        py = L::Select(hit, surface, py);
+        vy = L::Select(L::And(hit, L::Less(vy, zero)), zero, vy);
+
+        // Spin about cross(-v_flat, up) = (vz, 0, -vx), at |v_flat| / RADIUS
+        M moving = L::Greater(L::Sqrt(L::Add(L::Mul(vx, vx), L::Mul(vz, vz))), L::Set(MIN_SPEED));
+        L::Store(a[6] + i, L::Select(moving, L::Mul(vz, invRadius), zero));
+        L::Store(a[7] + i, zero);
+        L::Store(a[8] + i, L::Select(moving, L::Mul(L::Sub(zero, vx), invRadius), zero));
+
+        L::Store(a[0] + i, px), L::Store(a[1] + i, py), L::Store(a[2] + i, pz);
+        L::Store(a[3] + i, vx), L::Store(a[4] + i, vy), L::Store(a[5] + i, vz);
+    }
+    return i;
+}
+
+#ifdef BALLSYSTEM_X86
+
+static int integrateSSE2(float *const *a, int begin, int end, float dt, float travel, float friction,
+                         float rollingFriction) {
+    return integrateLanes<SSE2Lanes>(a, begin, end, dt, travel, friction, rollingFriction);
+}
+
+static int tableSSE2(float *const *a, int begin, int end) {
+    return tableLanes<SSE2Lanes>(a, begin, end);
+}
+
+#ifdef BALLSYSTEM_AVX2
+
+BALLSYSTEM_TARGET_AVX2
+static int integrateAVX2(float *const *a, int begin, int end, float dt, float travel, float friction,
+                         float rollingFriction) {
+    return integrateLanes<AVX2Lanes>(a, begin, end, dt, travel, friction, rollingFriction);
+}
+
+BALLSYSTEM_TARGET_AVX2
+static int tableAVX2(float *const *a, int begin, int end) {
+    return tableLanes<AVX2Lanes>(a, begin, end);
+}
+
+static bool hasAVX2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+#endif
+
+void BallSystem::AlignedDelete::operator()(float *p) const {
+    ::operator delete[](p, std::align_val_t(ALIGNMENT));
+}
+
+/**
+ * @fn Reserve
+ * @brief Grows the arrays to hold at least the given number of balls.
+ * New lanes, including the padding the kernels run over, hold a ball at rest at the origin.
+ */
+void BallSystem::Reserve(int balls) {
+    if (balls <= capacity) return;
+    int newCapacity = std::max(balls, capacity * 2);
+    newCapacity = (newCapacity + LANES - 1) / LANES * LANES;
+    const size_t floats = (size_t) newCapacity * FIELD_COUNT;
+    std::unique_ptr<float[], AlignedDelete> grown(
+            static_cast<float *>(::operator new[](floats * sizeof(float), std::align_val_t(ALIGNMENT))));
+    std::fill(grown.get(), grown.get() + floats, 0.0f);
+    for (Field field: {QW, PREV_QW})
+        std::fill(grown.get() + (size_t) field * newCapacity, grown.get() + (size_t) (field + 1) * newCapacity, 1.0f);
+    for (int field = 0; field < FIELD_COUNT && count > 0; ++field)
+        std::memcpy(grown.get() + (size_t) field * newCapacity, Array((Field) field), (size_t) count * sizeof(float));
+    storage = std::move(grown);
+    capacity = newCapacity;
+}
+
+int BallSystem::Add(const glm::vec3 &position) {
+    Reserve(count + 1);
+    const int i = count++;
+    Set(PX, i, position);
+    Set(VX, i, glm::vec3(0.0f));
+    Set(WX, i, glm::vec3(0.0f));
+    Set(PREV_PX, i, position);
+    Array(QX)[i] = Array(QY)[i] = Array(QZ)[i] = 0.0f;
+    Array(PREV_QX)[i] = Array(PREV_QY)[i] = Array(PREV_QZ)[i] = 0.0f;
+    Array(QW)[i] = Array(PREV_QW)[i] = 1.0f;
+    ballCell.push_back(-1);
+    nextInCell.push_back(-1);
+    prevInCell.push_back(-1);
+    return i;
+}
+
+void BallSystem::Clear() {
+    count = 0;
+    cellHead.clear();
+    ballCell.clear();
+    nextInCell.clear();
+    prevInCell.clear();
+}
+
+glm::vec3 BallSystem::Get(Field first, int i) const {
+    return {Array(first)[i], Array((Field) (first + 1))[i], Array((Field) (first + 2))[i]};
+}
+
+void BallSystem::Set(Field first, int i, const glm::vec3 &value) {
+    Array(first)[i] = value.x;
+    Array((Field) (first + 1))[i] = value.y;
+    Array((Field) (first + 2))[i] = value.z;
+}
+
+/**
+ * @brief Expands a unit quaternion into a column-major rotation matrix.
+ */
+static glm::mat4 rotationMatrix(float x, float y, float z, float w) {
+    glm::mat4 m(1.0f);
+    m[0][0] = 1.0f - 2.0f * (y * y + z * z);
+    m[0][1] = 2.0f * (x * y + w * z);
+    m[0][2] = 2.0f * (x * z - w * y);
+    m[1][0] = 2.0f * (x * y - w * z);
+    m[1][1] = 1.0f - 2.0f * (x * x + z * z);
+    m[1][2] = 2.0f * (y * z + w * x);
+    m[2][0] = 2.0f * (x * z + w * y);
+    m[2][1] = 2.0f * (y * z - w * x);
+    m[2][2] = 1.0f - 2.0f * (x * x + y * y);
+    return m;
+}
+
+glm::mat4 BallSystem::GetRotation(int i) const {
+    return rotationMatrix(Array(QX)[i], Array(QY)[i], Array(QZ)[i], Array(QW)[i]);
+}
+
+glm::vec3 BallSystem::GetPosition(int i, float alpha) const {
+    return glm::mix(Get(PREV_PX, i), Get(PX, i), alpha);
+}
+
+/**
+ * @fn GetRotation
+ * @brief Blends the two orientations linearly along the shorter arc and renormalizes; over one
+ * step the angle is small enough that this matches spherical interpolation.
+ */
+glm::mat4 BallSystem::GetRotation(int i, float alpha) const {
+    const glm::vec4 current(Array(QX)[i], Array(QY)[i], Array(QZ)[i], Array(QW)[i]);
+    glm::vec4 previous(Array(PREV_QX)[i], Array(PREV_QY)[i], Array(PREV_QZ)[i], Array(PREV_QW)[i]);
+    if (glm::dot(previous, current) < 0.0f) previous = -previous;
+    const glm::vec4 q = glm::normalize(glm::mix(previous, current, alpha));
+    return rotationMatrix(q.x, q.y, q.z, q.w);
+}
+
+/**
+ * @fn SaveState
+ * @brief Copies the position and orientation arrays, padding included, to their PREV_* twins.
+ */
+void BallSystem::SaveState() {
+    if (count == 0) return;
+    const size_t bytes = (size_t) capacity * sizeof(float);
+    std::memcpy(Array(PREV_PX), Array(PX), 3 * bytes);
+    std::memcpy(Array(PREV_QX), Array(QX), 4 * bytes);
+}
+
+void BallSystem::Integrate(float deltaTime, float friction, float rollingFriction) {
+    Integrate(deltaTime, deltaTime, friction, rollingFriction);
+}
+
+/**
+ * @fn Integrate
+ * @brief Runs the widest available kernel over all balls and their padding.
+ */
+void BallSystem::Integrate(float deltaTime, float travel, float friction, float rollingFriction) {
+    if (count == 0) return;
+    float *fields[FIELD_COUNT];
+    for (int field = 0; field < FIELD_COUNT; ++field) fields[field] = Array((Field) field);
+    const int padded = (count + LANES - 1) / LANES * LANES;
+    int i = 0;
+#ifdef BALLSYSTEM_X86
+#ifdef BALLSYSTEM_AVX2
+    if (hasAVX2()) i = integrateAVX2(fields, i, padded, deltaTime, travel, friction, rollingFriction);
+#endif
+    i = integrateSSE2(fields, i, padded, deltaTime, travel, friction, rollingFriction);
+#endif
+    integrateLanes<ScalarLanes>(fields, i, count, deltaTime, travel, friction, rollingFriction);
+}
+
+/**
+ * @fn CellOf
+ * @brief Gets the grid cell under a ball's centre. Balls off the play area count as in the nearest
+ * edge cell, which can only add candidate pairs, never lose one.
+ */
+int BallSystem::CellOf(int i) const {
+    const int x = (int) std::floor((Array(PX)[i] + Constants::PLAY_LENGTH / 2.0f) / CELL_SIZE);
+    const int z = (int) std::floor((Array(PZ)[i] + Constants::PLAY_WIDTH / 2.0f) / CELL_SIZE);
+    return std::clamp(z, 0, GRID_Z - 1) * GRID_X + std::clamp(x, 0, GRID_X - 1);
+}
+
+/**
+ * @fn UpdateGrid
+ * @brief Relinks only the balls that crossed into another cell since the last update.
+ */
+void BallSystem::UpdateGrid() {
+    if (cellHead.empty()) cellHead.assign((size_t) GRID_X * GRID_Z, -1);
+    for (int i = 0; i < count; ++i) {
+        const int cell = CellOf(i);
+        const int old = ballCell[i];
+        if (cell == old) continue;
+        if (old >= 0) {
+            if (prevInCell[i] >= 0) nextInCell[prevInCell[i]] = nextInCell[i];
+            else cellHead[old] = nextInCell[i];
+            if (nextInCell[i] >= 0) prevInCell[nextInCell[i]] = prevInCell[i];
+        }
+        prevInCell[i] = -1;
+        nextInCell[i] = cellHead[cell];
+        if (cellHead[cell] >= 0) prevInCell[cellHead[cell]] = i;
+        cellHead[cell] = i;
+        ballCell[i] = cell;
+    }
+}
+
+/**
+ * @fn ResolveBallCollisions
+ * @brief Takes the balls in index order and pairs each with the later balls in its own and the
+ * eight surrounding cells, sorted, so pairs come in the same order as when testing every pair.
+ */
+void BallSystem::ResolveBallCollisions() {
+    UpdateGrid();
+    for (int a = 0; a < count; ++a) {
+        const int cx = ballCell[a] % GRID_X;
+        const int cz = ballCell[a] / GRID_X;
+        neighbours.clear();
+        for (int nz = std::max(cz - 1, 0); nz <= std::min(cz + 1, GRID_Z - 1); ++nz)
+            for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, GRID_X - 1); ++nx)
+                for (int b = cellHead[nz * GRID_X + nx]; b >= 0; b = nextInCell[b])
+                    if (b > a) neighbours.push_back(b);
+        std::sort(neighbours.begin(), neighbours.end());
+        for (int b: neighbours) ResolveBallCollision(a, b);
+    }
+}
+
+/**
+ * @fn ResolveBallCollision
+ * @brief Pushes two overlapping balls apart until they touch, then bounces them.
+ */
+void BallSystem::ResolveBallCollision(int a, int b) {
+    const glm::vec3 delta = GetPosition(b) - GetPosition(a);
+    // Most candidate pairs are apart; reject them before taking the square root
+    const float dist2 = glm::dot(delta, delta);
+    if (dist2 >= 4 * RADIUS * RADIUS || dist2 <= 0.0f) return;
+    const float dist = std::sqrt(dist2);
+    if (dist >= 2 * RADIUS) return;
+    const glm::vec3 normal = delta / dist;
+    const float overlap = 2 * RADIUS - dist;
+    SetPosition(a, GetPosition(a) - normal * (overlap / 2.0f));
+    SetPosition(b, GetPosition(b) + normal * (overlap / 2.0f));
+    Bounce(a, b, normal);
+}
+
+/**
+ * @fn Bounce
+ * @brief Swaps the velocity components of two touching balls along the normal from a to b
+ * (an elastic collision of equal masses) and sets their spins to roll along their new directions.
+ */
+void BallSystem::Bounce(int a, int b, const glm::vec3 &normal) {
+    const glm::vec3 va = GetVelocity(a);
+    const glm::vec3 vb = GetVelocity(b);
+    const float v1 = glm::dot(va, normal);
+    const float v2 = glm::dot(vb, normal);
+    SetVelocity(a, va + (v2 - v1) * normal);
+    SetVelocity(b, vb + (v1 - v2) * normal);
+    // Rolling axis is cross(up, -v_flat) = (-vz, 0, vx), from the new velocity rather than the normal
+    for (int i: {a, b}) {
+        const glm::vec3 v = GetVelocity(i);
+        const bool moving = glm::length(glm::vec3(v.x, 0.0f, v.z)) > MIN_SPEED;
+        SetAngularVelocity(i, moving ? glm::vec3(-v.z, 0.0f, v.x) / RADIUS : glm::vec3(0.0f));
+    }
+}
+
+/**
+ * @fn ResolveTableCollisions
+ * @brief Runs the widest available cushion kernel over all balls and their padding.
+ */
+void BallSystem::ResolveTableCollisions() {
+    if (count == 0) return;
+    float *fields[FIELD_COUNT];
+    for (int field = 0; field < FIELD_COUNT; ++field) fields[field] = Array((Field) field);
+    const int padded = (count + LANES - 1) / LANES * LANES;
+    int i = 0;
+#ifdef BALLSYSTEM_X86
+#ifdef BALLSYSTEM_AVX2
+    if (hasAVX2()) i = tableAVX2(fields, i, padded);
+#endif
+    i = tableSSE2(fields, i, padded);
+#endif
+    tableLanes<ScalarLanes>(fields, i, count);
+}
+
+/**
+ * @brief Gets the time two balls moving in straight lines first touch, infinity if they never do.
+ * @param dp Centre of the second ball relative to the first.
+ * @param dv Velocity of the second ball relative to the first.
+ */
+static float timeOfImpact(const glm::vec3 &dp, const glm::vec3 &dv) {
+    const float b = glm::dot(dp, dv);
+    if (b >= 0.0f) return INFINITY; // Not approaching
+    const float c = glm::dot(dp, dp) - 4 * RADIUS * RADIUS;
+    if (c <= 0.0f) return 0.0f; // Already touching
+    const float disc = b * b - glm::dot(dv, dv) * c;
+    if (disc < 0.0f) return INFINITY; // Passing each other
+    // Smaller root of |dp + dv t| = 2 RADIUS, in the form without cancellation
+    return c / (std::sqrt(disc) - b);
+}
+
+/**
+ * @brief Gets the time a ball moving along one axis reaches a cushion, infinity if it moves away.
+ */
+static float timeToCushion(float position, float velocity, float min, float max) {
+    if (velocity > 0.0f) return std::max(0.0f, (max - position) / velocity);
+    if (velocity < 0.0f) return std::max(0.0f, (min - position) / velocity);
+    return INFINITY;
+}
+
+/**
+ * @fn Step
+ * @brief Updates velocities without moving, sweeps the balls through the step, then cleans up.
+ */
+void BallSystem::Step(float deltaTime, float friction, float rollingFriction) {
+    Integrate(deltaTime, 0.0f, friction, rollingFriction);
+    float remaining = deltaTime;
+    for (int contacts = 0; contacts < MAX_CONTACTS_PER_STEP && remaining > 0.0f; ++contacts) {
+        const Contact contact = FindFirstContact(remaining);
+        if (contact.a < 0) break;
+        Advance(contact.time);
+        remaining -= contact.time;
+        // Cushion contacts put the ball exactly on the cushion line and reflect it
+        if (contact.b >= 0) {
+            Bounce(contact.a, contact.b, glm::normalize(GetPosition(contact.b) - GetPosition(contact.a)));
+        } else if (contact.b == Contact::CUSHION_X) {
+            float &v = Array(VX)[contact.a];
+            Array(PX)[contact.a] = v > 0.0f ? MAX_X : MIN_X;
+            v = -v;
+        } else {
+            float &v = Array(VZ)[contact.a];
+            Array(PZ)[contact.a] = v > 0.0f ? MAX_Z : MIN_Z;
+            v = -v;
+        }
+    }
+    Advance(remaining);
+    ResolveBallCollisions();
+    ResolveTableCollisions();
+}
+
+/**
+ * @fn FindFirstContact
+ * @brief Finds the earliest contact before the given time, or returns one with a = -1.
+ * A pair can only touch within the time if the balls are closer than two radii plus the distance
+ * both travel, so each pair is searched for from its faster ball, over the grid cells that ball
+ * can reach; balls at rest search nothing. Speeds are taken in the table plane: gravity gives every
+ * ball the same vertical velocity within a step, so it never brings a pair closer, and counting it
+ * would make a resting rack search as if it were moving.
+ */
+BallSystem::Contact BallSystem::FindFirstContact(float within) {
+    Contact first{within, -1, 0};
+    UpdateGrid();
+    speeds.resize((size_t) count);
+    for (int i = 0; i < count; ++i) speeds[i] = glm::length(glm::vec2(Array(VX)[i], Array(VZ)[i]));
+    for (int a = 0; a < count; ++a) {
+        if (speeds[a] <= 0.0f) continue;
+        const glm::vec3 pa = GetPosition(a);
+        const glm::vec3 va = GetVelocity(a);
+        float t = timeToCushion(pa.x, va.x, MIN_X, MAX_X);
+        if (t < first.time) first = {t, a, Contact::CUSHION_X};
+        t = timeToCushion(pa.z, va.z, MIN_Z, MAX_Z);
+        if (t < first.time) first = {t, a, Contact::CUSHION_Z};
+
+        const float reach = 2 * RADIUS + 2 * speeds[a] * first.time;
+        const int cells = (int) std::min(std::ceil(reach / CELL_SIZE), (float) std::max(GRID_X, GRID_Z));
+        const int cx = ballCell[a] % GRID_X;
+        const int cz = ballCell[a] / GRID_X;
+        for (int nz = std::max(cz - cells, 0); nz <= std::min(cz + cells, GRID_Z - 1); ++nz) {
+            for (int nx = std::max(cx - cells, 0); nx <= std::min(cx + cells, GRID_X - 1); ++nx) {
+                for (int b = cellHead[nz * GRID_X + nx]; b >= 0; b = nextInCell[b]) {
+                    if (speeds[b] > speeds[a] || (speeds[b] == speeds[a] && b <= a)) continue;
+                    t = timeOfImpact(GetPosition(b) - pa, GetVelocity(b) - va);
+                    if (t < first.time) first = {t, a, b};
+                }
+            }
+        }
+    }
+    return first;
+}
+
+/**
+ * @fn Advance
+ * @brief Moves every ball along its velocity for the given time.
+ */
+void BallSystem::Advance(float time) {
+    if (time <= 0.0f) return;
+    static constexpr Field AXES[3][2] = {{PX, VX}, {PY, VY}, {PZ, VZ}};
+    for (const auto &axis: AXES) {
+        float *p = Array(axis[0]);
+        const float *v = Array(axis[1]);
+        for (int i = 0; i < count; ++i) p[i] += v[i] * time;
+    }
+}
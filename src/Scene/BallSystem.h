@@ -0,0 +1,194 @@
+/**
+ * @file BallSystem.h
+ * @brief Header file for the BallSystem class.
+ * Holds the physics state of every ball in structure-of-arrays form, so one step of the
+ * simulation streams through a few contiguous float arrays instead of chasing one heap object
+ * per ball, and integrates four or eight balls at a time with SSE2 or AVX2.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_BALLSYSTEM_H
+#define BILLIARDSHOW_BALLSYSTEM_H
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class BallSystem
+ * @brief Positions, velocities, angular velocities and orientations of a set of balls.
+ * Each component lives in its own 32-byte aligned array, padded to a multiple of eight balls so
+ * the vector kernels never need a scalar tail. Orientations are unit quaternions rather than
+ * matrices. Balls are addressed by the index Add() returns; Ball objects are handles to them.
+ * The positions and orientations before the last step are kept too, so rendering can interpolate
+ * between the last two steps of a fixed-rate simulation.
+ * Ball-ball collisions go through a uniform grid over the play area, so only balls in neighbouring
+ * cells are tested against each other. Step() adds continuous collision detection: balls move
+ * along their swept paths and contacts are resolved in time order, so fast balls cannot pass
+ * through each other or a cushion within a step.
+ */
+class BallSystem {
+public:
+    BallSystem() = default;
+
+    BallSystem(const BallSystem &) = delete;
+
+    BallSystem &operator=(const BallSystem &) = delete;
+
+    /**
+     * @brief Adds a ball at rest with the identity orientation.
+     * @param position Initial position of the ball.
+     * @return Index of the new ball.
+     */
+    int Add(const glm::vec3 &position);
+
+    /**
+     * @brief Removes every ball.
+     */
+    void Clear();
+
+    int GetCount() const { return count; }
+
+    glm::vec3 GetPosition(int i) const { return Get(PX, i); }
+
+    void SetPosition(int i, const glm::vec3 &position) { Set(PX, i, position); }
+
+    glm::vec3 GetVelocity(int i) const { return Get(VX, i); }
+
+    void SetVelocity(int i, const glm::vec3 &velocity) { Set(VX, i, velocity); }
+
+    glm::vec3 GetAngularVelocity(int i) const { return Get(WX, i); }
+
+    void SetAngularVelocity(int i, const glm::vec3 &angularVelocity) { Set(WX, i, angularVelocity); }
+
+    /**
+     * @brief Gets the orientation of a ball as a rotation matrix.
+     */
+    glm::mat4 GetRotation(int i) const;
+
+    /**
+     * @brief Gets the position of a ball between the previous step and the current one.
+     * @param alpha 0 for the state before the last step, 1 for the current state.
+     */
+    glm::vec3 GetPosition(int i, float alpha) const;
+
+    /**
+     * @brief Gets the orientation of a ball between the previous step and the current one.
+     * @param alpha 0 for the state before the last step, 1 for the current state.
+     */
+    glm::mat4 GetRotation(int i, float alpha) const;
+
+    /**
+     * @brief Records the current positions and orientations as the previous state.
+     * Call before each step, and after moving balls directly so they do not appear to slide there.
+     */
+    void SaveState();
+
+    /**
+     * @brief Moves every ball by one time step: gravity, rolling spin, friction and rolling friction.
+     * Runs the AVX2 kernel when the CPU has it, otherwise SSE2, otherwise scalar code; all three
+     * perform the same float operations and produce the same results.
+     * @param deltaTime The time step in seconds.
+     * @param friction The sliding friction coefficient.
+     * @param rollingFriction The rolling friction coefficient.
+     */
+    void Integrate(float deltaTime, float friction, float rollingFriction);
+
+    /**
+     * @brief Advances every ball by one time step with continuous collision detection.
+     * Velocities and spins are updated as in Integrate(). Then the balls move in straight lines,
+     * stopping at each contact in time order: the earliest ball-ball or ball-cushion contact within
+     * the step is found by swept-sphere time of impact, all balls advance to it, it is resolved and
+     * the search repeats for the rest of the step. Overlaps and cushions are then cleaned up as
+     * without continuous detection, which also covers anything the per-step contact limit leaves.
+     * @param deltaTime The time step in seconds; it can be far longer than with Integrate().
+     * @param friction The sliding friction coefficient.
+     * @param rollingFriction The rolling friction coefficient.
+     */
+    void Step(float deltaTime, float friction, float rollingFriction);
+
+    /**
+     * @brief Separates overlapping balls and exchanges their velocities along the contact normal.
+     * Moves the balls whose cell changed since the last call to their new cell, then resolves only
+     * the pairs in the same or adjacent cells, in the order testing every pair would use.
+     */
+    void ResolveBallCollisions();
+
+    /**
+     * @brief Resolves one pair of balls, if they overlap.
+     */
+    void ResolveBallCollision(int a, int b);
+
+    /**
+     * @brief Keeps every ball inside the play area and on the cloth, bouncing it off the cushions.
+     */
+    void ResolveTableCollisions();
+
+private:
+    // Component arrays, in the order they are laid out in storage; PREV_* hold the state SaveState() recorded
+    enum Field {
+        PX, PY, PZ, VX, VY, VZ, WX, WY, WZ, QX, QY, QZ, QW,
+        PREV_PX, PREV_PY, PREV_PZ, PREV_QX, PREV_QY, PREV_QZ, PREV_QW,
+        FIELD_COUNT
+    };
+
+    static constexpr int LANES = 8;     // Padding granularity, the widest kernel's lane count
+    static constexpr size_t ALIGNMENT = 32;
+
+    struct AlignedDelete {
+        void operator()(float *p) const;
+    };
+
+    float *Array(Field field) { return storage.get() + (size_t) field * capacity; }
+
+    const float *Array(Field field) const { return storage.get() + (size_t) field * capacity; }
+
+    glm::vec3 Get(Field first, int i) const;
+
+    void Set(Field first, int i, const glm::vec3 &value);
+
+    /**
+     * @struct Contact
+     * @brief A contact found by the sweep: ball a touches ball b, or a cushion when b is negative.
+     */
+    struct Contact {
+        enum { CUSHION_X = -1, CUSHION_Z = -2 };
+
+        float time;
+        int a;
+        int b;
+    };
+
+    void Reserve(int balls);
+
+    void Integrate(float deltaTime, float travel, float friction, float rollingFriction);
+
+    Contact FindFirstContact(float within);
+
+    void Advance(float time);
+
+    void Bounce(int a, int b, const glm::vec3 &normal);
+
+    int CellOf(int i) const;
+
+    void UpdateGrid();
+
+    std::unique_ptr<float[], AlignedDelete> storage;
+    int count = 0;
+    int capacity = 0; // Balls each array has room for, a multiple of LANES
+
+    // Broadphase grid: each cell holds a doubly linked list of the balls whose centre is in it
+    std::vector<int> cellHead;  // First ball of each cell, -1 if empty
+    std::vector<int> ballCell;  // Cell of each ball, -1 until first placed
+    std::vector<int> nextInCell;
+    std::vector<int> prevInCell;
+    std::vector<int> neighbours; // Candidates of the ball being resolved, kept to reuse the memory
+    std::vector<float> speeds;   // Speed of each ball during a sweep
+};
+
+#endif //BILLIARDSHOW_BALLSYSTEM_H
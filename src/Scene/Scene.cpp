@@ -24,7 +24,7 @@ Scene::~Scene() {
  * This method creates a new Table object and sets it up for rendering.
  * It also prepares the ball positions for the initial setup.
  */
-void Scene::Render() {
+void Scene::Render(float alpha) {
     // Draw table base
     Shader *shader = Shader::GetActiveShader();
     auto model = glm::mat4(1.0f);
@@ -43,7 +43,7 @@ void Scene::Render() {
 
     // Draw balls
     // Configure shader for ball rendering
-    shader->setBool("useTexture", true); // Enable texture for balls
+    shader->setBool("useTexture", false); // Balls sample the texture array instead
     shader->setVec3("objectColor", glm::vec3(1.0f, 1.0f, 1.0f)); // Default ball color
     shader->setMat4("model", glm::mat4(1.0f)); // Reset model matrix
 
@@ -52,13 +52,17 @@ void Scene::Render() {
         return;
     }
 
+    // All ball textures are layers of one array: bind it once, each ball only sets its layer
+    ballTextures.Bind(1);
+    shader->setBool("useTextureArray", ballTextures.IsValid());
     for (int i = 0; i < balls.size(); ++i) {
         if (balls[i]) {
-            balls[i]->Render(renderer, Constants::BALL_SCALE); // Render each ball with scale 1.0
+            balls[i]->Render(renderer, Constants::BALL_SCALE, alpha); // Render each ball with scale 1.0
         } else {
             Logger::Error("Ball at index " + std::to_string(i) + " is null in Scene::Render");
         }
     }
+    shader->setBool("useTextureArray", false);
 }
 
 /** @brief Sets the renderer for the scene.
@@ -81,19 +85,90 @@ void Scene::SetRenderer(Renderer *_renderer) {
  */
 // In Scene.cpp
 void Scene::InstallBalls() {
-    // No longer needed, handled in LoadBallsThreaded
+    // The layers were planned, and the images resampled to their size, when the balls loaded
+    if (!ballLayerPaths.empty() &&
+        ballTextures.Allocate(ballLayerWidth, ballLayerHeight, (int) ballLayerPaths.size(), ballLayerFormat)) {
+        std::vector<bool> claimed(ballLayerPaths.size(), false);
+        for (size_t i = 0; i < balls.size() && i < ballLayers.size(); ++i) {
+            if (ballLayers[i] < 0) continue;
+            balls[i]->GetModel()->SetTextureLayer(&ballTextures, ballLayers[i], !claimed[ballLayers[i]]);
+            claimed[ballLayers[i]] = true;
+        }
+    } else {
+        ballLayerPaths.clear();
+    }
+
     for (auto *ball: balls)
         if (ball) ball->Install();
         else Logger::Error("Ball is null in InstallBalls");
 }
 
+/** @brief Registers the ball textures and meshes with a hot reloader.
+ * Textures are decoded, and resampled to the layer size, on the reloader's worker; the apply step
+ * only re-uploads the layer. A changed image whose format no longer matches the array (for example
+ * one that gained transparency while the array is BC1) cannot go into it and needs a restart.
+ * Meshes are imported again on the worker and installed and swapped in by the apply step; only the
+ * balls loaded from the changed file get the new mesh. Generated spheres have no mesh file.
+ * @param reloader The reloader to register with.
+ */
+void Scene::EnableHotReload(HotReloader &reloader) {
+    for (int layer = 0; layer < (int) ballLayerPaths.size(); ++layer) {
+        reloader.Register(ballLayerPaths[layer], [this, layer](const std::string &path) -> HotReloader::Apply {
+            auto texture = std::make_shared<Texture>();
+            std::string problem;
+            if (!texture->Decode(path))
+                problem = "it could not be decoded";
+            else if (texture->GetFormat() != ballTextures.GetFormat())
+                problem = "its format no longer matches the ball texture array, restart to load it";
+            else if (!texture->Resample(ballTextures.GetWidth(), ballTextures.GetHeight()))
+                problem = "it could not be resized to the ball texture array";
+            return [this, layer, texture, problem, path]() {
+                if (problem.empty() && ballTextures.UploadLayer(layer, texture->GetStaging()))
+                    Logger::Info("Reloaded ball texture " + path);
+                else
+                    Logger::Warn("Keeping the previous ball texture for " + path +
+                                 (problem.empty() ? "" : ": " + problem));
+            };
+        });
+    }
+
+    if (ballSegments > 0) return;
+    std::vector<std::string> meshPaths;
+    for (auto *ball: balls) {
+        ObjectLoader *model = ball ? ball->GetModel() : nullptr;
+        if (model && std::find(meshPaths.begin(), meshPaths.end(), model->GetSourcePath()) == meshPaths.end())
+            meshPaths.push_back(model->GetSourcePath());
+    }
+    for (const auto &meshPath: meshPaths) {
+        reloader.Register(meshPath, [this](const std::string &path) -> HotReloader::Apply {
+            std::shared_ptr<Mesh> mesh = MeshCache::Instance().Reload(path);
+            return [this, mesh, path]() {
+                if (!mesh || !mesh->Install()) {
+                    Logger::Warn("Keeping the previous mesh for " + path);
+                    return;
+                }
+                for (auto *ball: balls) {
+                    ObjectLoader *model = ball ? ball->GetModel() : nullptr;
+                    if (model && AssetArchive::NormalizePath(model->GetSourcePath()) == path) model->SetMesh(mesh);
+                }
+                Logger::Info("Reloaded mesh " + path);
+            };
+        });
+    }
+}
+
 /** @brief Loads balls in a separate thread.
  * This method initializes the ball positions and creates Ball objects with their models.
- * It uses atomic variables to track progress and completion status.
- * @param progress Pointer to an atomic float for tracking loading progress.
- * @param done Pointer to an atomic bool for signaling completion.
+ * The models are loaded in parallel on a pool of worker threads.
+ * Each ball adds the sizes of its asset files to the progress total when its load starts, and
+ * advances the progress by the bytes it processes. A stop request skips queued balls and interrupts
+ * running ones.
+ * @param progress Byte counter for tracking loading progress, may be null.
+ * @param done Pointer to an atomic bool for signaling completion; left false if cancelled.
+ * @param stop Token that cancels the load.
+ * @return True if every ball finished loading, false if the load was cancelled.
  */
-void Scene::LoadBallsThreaded(std::atomic<float> *progress, std::atomic<bool> *done) {
+bool Scene::LoadBallsThreaded(LoadProgress *progress, std::atomic<bool> *done, std::stop_token stop) {
     // Place balls for match start (triangle formation, apex at a head spot)
     float rowSpacing = Ball::RADIUS * 2.0f + 0.001f; // Small gap between rows
     float colSpacing = Ball::RADIUS * 2.0f + 0.001f; // Small gap between balls in a row
@@ -119,51 +194,155 @@ void Scene::LoadBallsThreaded(std::atomic<float> *progress, std::atomic<bool> *d
     // Create Ball objects and assign models/textures
     balls.resize(ballPositions.size());
     int numBalls = (int) ballPositions.size();
-    for (int i = 0; i < numBalls; ++i) {
-        Ball *ball = new Ball(i + 1, ballPositions[i]);
-        ObjectLoader *model = new ObjectLoader(); // Copy the shared model
-        std::string objPath = OBJ_PATH "Ball" + std::to_string(i % 15 + 1) + ".obj"; // Cycle through 15 ball models
-        model->Load(objPath);
-        ball->SetModel(model);
-        balls[i] = ball;
-        if (progress) *progress = float(i + 1) / (float) numBalls;
-        Logger::Info("Loaded ball model " + std::to_string(i + 1));
+    for (int i = 0; i < numBalls; ++i)
+        balls[i] = new Ball(ballSystem, i + 1, ballPositions[i]);
+
+    std::vector<std::string> assetPaths(numBalls);
+    for (int i = 0; i < numBalls; ++i) assetPaths[i] = BallAssetPath(i);
+    if (progress) progress->ExpectTotals(numBalls);
+
+    // Spread the per-ball work (OBJ/MTL parsing, JPEG decoding) across the worker pool.
+    // Load() makes no OpenGL calls; uploads happen later in InstallBalls() on the main thread.
+    // Measuring names the MTL and texture files, which needs the OBJ and MTL contents, so every
+    // ball measures its own files: none waits for another ball's files to arrive.
+    {
+        ThreadPool pool(loaderThreads);
+        Logger::Info("Loading " + std::to_string(numBalls) + " balls on " + std::to_string(pool.GetThreadCount()) +
+                     " worker threads");
+        for (int i = 0; i < numBalls; ++i) {
+            pool.Submit([this, i, progress, stop, &assetPaths]() {
+                if (stop.stop_requested()) return;
+                if (progress)
+                    progress->AddExpectedTotal(ballSegments > 0 ? ObjectLoader::MeasureMaterial(assetPaths[i])
+                                                                : ObjectLoader::MeasureAssets(assetPaths[i]));
+                ObjectLoader *model = new ObjectLoader();
+                const bool loaded = ballSegments > 0
+                                        ? model->LoadSphere(ballSegments, assetPaths[i], stop, progress)
+                                        : model->Load(assetPaths[i], stop, progress);
+                if (!loaded && stop.stop_requested()) {
+                    delete model;
+                    return;
+                }
+                balls[i]->SetModel(model);
+                Logger::Info("Loaded ball model " + std::to_string(i + 1));
+            });
+        }
+        pool.Wait();
+        if (!stop.stop_requested()) PlanBallLayers(pool, stop);
+    }
+    if (stop.stop_requested()) {
+        Logger::Info("Ball loading cancelled");
+        return false;
     }
-    //delete sharedBallModel; // Clean up if not needed
     Logger::Info("All ball models loaded and assigned.");
 
     if (done) *done = true;
+    return true;
+}
+
+/** @brief Gives every distinct ball texture one layer of the shared array InstallBalls() allocates.
+ * The layers take the size of the largest image and the format of the first one (all are BC1 when
+ * compression is on, RGBA8 otherwise). Balls sharing a texture file share a layer, and the first of
+ * them uploads it. Smaller images are resampled to the layer size here on the loader workers, BC1 ones
+ * through RGBA8, so installing them on the GL thread is only a copy.
+ * @param pool The loader workers, idle when called.
+ * @param stop Token that cancels the resampling.
+ */
+void Scene::PlanBallLayers(ThreadPool &pool, std::stop_token stop) {
+    ballLayerPaths.clear();
+    ballLayers.assign(balls.size(), -1);
+    ballLayerWidth = ballLayerHeight = 0;
+    ballLayerFormat = GL_RGBA8;
+    std::vector<ObjectLoader *> uploaders;
+    for (size_t i = 0; i < balls.size(); ++i) {
+        ObjectLoader *model = balls[i] ? balls[i]->GetModel() : nullptr;
+        if (!model || !model->GetTexture().HasPendingUpload()) continue;
+        const Texture &texture = model->GetTexture();
+        auto it = std::find(ballLayerPaths.begin(), ballLayerPaths.end(), texture.GetSourcePath());
+        ballLayers[i] = (int) (it - ballLayerPaths.begin());
+        if (it == ballLayerPaths.end()) {
+            if (ballLayerPaths.empty()) ballLayerFormat = texture.GetFormat();
+            ballLayerPaths.push_back(texture.GetSourcePath());
+            uploaders.push_back(model);
+            ballLayerWidth = std::max(ballLayerWidth, texture.GetWidth());
+            ballLayerHeight = std::max(ballLayerHeight, texture.GetHeight());
+        }
+    }
+
+    // Images in another format cannot go into the array at all; Install() reports them
+    for (ObjectLoader *model: uploaders) {
+        const Texture &texture = model->GetTexture();
+        if (texture.GetFormat() != ballLayerFormat ||
+            (texture.GetWidth() == ballLayerWidth && texture.GetHeight() == ballLayerHeight))
+            continue;
+        pool.Submit([this, model, stop]() {
+            if (stop.stop_requested()) return;
+            if (!model->ResampleTexture(ballLayerWidth, ballLayerHeight))
+                Logger::Warn("Could not resize ball texture " + model->GetTexture().GetSourcePath() +
+                             " to the texture array");
+        });
+    }
+    pool.Wait();
+}
+
+/** @brief Gets the file a ball model is loaded from.
+ * With a ball tessellation set, only the materials are read and the geometry is generated.
+ * @param ball Index of the ball; the 15 ball models are cycled through.
+ */
+std::string Scene::BallAssetPath(int ball) const {
+    return OBJ_PATH "Ball" + std::to_string(ball % 15 + 1) + (ballSegments > 0 ? ".mtl" : ".obj");
+}
+
+/** @brief Lists the files LoadBallsThreaded starts each ball model from, without reading any.
+ * The MTL and texture files are named inside these; ObjectLoader::ListReferencedAssets finds them.
+ * @return The OBJ file of every ball model, or its MTL file when the geometry is generated.
+ */
+std::vector<std::string> Scene::ListBallModelFiles() const {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 15; ++i) paths.push_back(BallAssetPath(i));
+    return paths;
+}
+
+/** @brief Sets the number of worker threads used by LoadBallsThreaded.
+ * @param count Number of workers; 0 uses one per hardware thread.
+ */
+void Scene::SetLoaderThreadCount(unsigned int count) {
+    loaderThreads = count;
+}
+
+/** @brief Sets the tessellation of the procedurally generated ball spheres.
+ * @param segments Segments and rings of the finest sphere; 0 loads the OBJ geometry instead.
+ */
+void Scene::SetBallTessellation(int segments) {
+    ballSegments = segments;
+}
+
+/** @brief Sets whether ball contacts are found by continuous collision detection.
+ * @param enabled True to sweep the balls through each step.
+ */
+void Scene::SetContinuousCollisions(bool enabled) {
+    continuousCollisions = enabled;
 }
 
 /** @brief Updates the scene state.
  * This method updates the positions and velocities of all balls in the scene.
  * It handles ball-ball collisions and ball-table collisions.
- * @param deltaTime Time since the last update, used for physics calculations.
+ * The state before the step is kept for Render() to interpolate from.
+ * @param deltaTime Length of the physics step; App calls this at a fixed rate.
  */
 void Scene::Update(float deltaTime) {
-    // Move and apply friction
-    for (auto *ball: balls) {
-        if (ball) {
-            ball->Update(deltaTime);
-            ball->ApplyFriction(deltaTime, Constants::BALL_FRICTION);
-            ball->ApplyRollingFriction(deltaTime, Constants::BALL_ROLLING_FRICTION);
-        }
+    ballSystem.SaveState();
+    if (continuousCollisions) {
+        // Move, resolving contacts in the order they happen within the step
+        ballSystem.Step(deltaTime, Constants::BALL_FRICTION, Constants::BALL_ROLLING_FRICTION);
+        return;
     }
+    // Move and apply friction
+    ballSystem.Integrate(deltaTime, Constants::BALL_FRICTION, Constants::BALL_ROLLING_FRICTION);
     // Ball-ball collisions
-    for (size_t i = 0; i < balls.size(); ++i) {
-        for (size_t j = i + 1; j < balls.size(); ++j) {
-            if (balls[i] && balls[j]) {
-                balls[i]->ResolveBallCollision(*balls[j]);
-            }
-        }
-    }
+    ballSystem.ResolveBallCollisions();
     // Ball-table collisions
-    Table tableObj; // Or use your existing table pointer if available
-    for (auto *ball: balls) {
-        if (ball) {
-            ball->ResolveTableCollision(tableObj);
-        }
-    }
+    ballSystem.ResolveTableCollisions();
 }
 
 /** @brief Resets the positions of all balls to their initial positions.
@@ -178,6 +357,7 @@ void Scene::ResetBallPositions() {
             balls[i]->SetVelocity(glm::vec3(0.0f, 0.0f, 0.5f)); // Reset to initial velocity
         }
     }
+    ballSystem.SaveState(); // Jump to the start positions rather than sliding there
 }
 
 
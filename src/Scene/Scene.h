@@ -5,19 +5,27 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
 #include <future>
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <stop_token>
 #include <vector>
 #include <iostream>
 
 #include "../Renderer/Renderer.h"
 #include "../Loader/ObjectLoader.h"
+#include "../Loader/MeshCache.h"
+#include "../Renderer/TextureArray.h"
 #include "../App.h"
 #include "../Scene/Table.h"
+#include "../Utils/LoadProgress.h"
+#include "../Utils/HotReloader.h"
 #include "../Utils/Logger.h"
+#include "../Utils/ThreadPool.h"
 #include "Ball.h"
+#include "BallSystem.h"
 
 class Ball;
 
@@ -45,8 +53,9 @@ public:
      * @brief Renders the scene.
      * This method draws the billiard table and all balls in the scene.
      * It uses the Renderer to draw the objects.
+     * @param alpha How far the frame is between the last two physics steps; balls are drawn interpolated.
      */
-    void Render(); // Draw table and balls
+    void Render(float alpha = 1.0f); // Draw table and balls
 
     /**
      * @brief Sets the table for the scene.
@@ -58,12 +67,51 @@ public:
 
     /**
      * @brief Loads balls in a separate thread.
-     * This method initializes the ball positions and creates Ball objects with their models.
-     * It uses atomic variables to track progress and completion status.
-     * @param progress Pointer to an atomic float for tracking loading progress.
-     * @param done Pointer to an atomic bool for signaling completion.
+     * This method initializes the ball positions and creates Ball objects with their models,
+     * loading the models in parallel on a pool of worker threads.
+     * Progress is reported in bytes processed across all ball assets, and the load stops
+     * early when a stop is requested.
+     * @param progress Byte counter for tracking loading progress, may be null.
+     * @param done Pointer to an atomic bool for signaling completion; left false if cancelled.
+     * @param stop Token that cancels the load.
+     * @return True if every ball finished loading, false if the load was cancelled.
      */
-    void LoadBallsThreaded(std::atomic<float> *progress, std::atomic<bool> *done);
+    bool LoadBallsThreaded(LoadProgress *progress, std::atomic<bool> *done, std::stop_token stop = {});
+
+    /**
+     * @brief Lists the files LoadBallsThreaded starts each ball model from, so they can be prefetched.
+     * Honours the ball tessellation, which decides whether the OBJ files are read at all. Nothing is
+     * read; the MTL and texture files they name are found with ObjectLoader::ListReferencedAssets().
+     */
+    std::vector<std::string> ListBallModelFiles() const;
+
+    /**
+     * @brief Sets the number of worker threads LoadBallsThreaded spreads the ball loading across.
+     * @param count Number of workers; 0 uses one per hardware thread.
+     */
+    void SetLoaderThreadCount(unsigned int count);
+
+    /**
+     * @brief Sets whether the ball geometry is generated instead of loaded from the OBJ files.
+     * @param segments Segments and rings of the finest sphere; 0 loads the OBJ geometry.
+     */
+    void SetBallTessellation(int segments);
+
+    /**
+     * @brief Sets whether Update() sweeps the balls and resolves contacts in time order.
+     * Without it, contacts are only found as overlaps at the end of each step, so fast balls can
+     * pass through each other or the cushions unless the step is short.
+     * @param enabled True to use continuous collision detection.
+     */
+    void SetContinuousCollisions(bool enabled);
+
+    /**
+     * @brief Registers the ball textures and meshes with a hot reloader.
+     * A changed ball image is decoded again and re-uploaded into its texture array layer; a changed
+     * OBJ file is imported again and swapped into the balls loaded from it. Call after InstallBalls().
+     * @param reloader The reloader; it must not outlive the scene.
+     */
+    void EnableHotReload(HotReloader &reloader);
 
     /**
      * @brief Sets the renderer for the scene.
@@ -90,13 +138,31 @@ public:
     // Getter for ball positions
     const std::vector<glm::vec3> &GetBallPositions() const { return ballPositions; }
 
+    /**
+     * @brief Gets the physics state of the balls.
+     */
+    BallSystem &GetBallSystem() { return ballSystem; }
+
     std::vector<Ball *> balls;
 private:
+    std::string BallAssetPath(int ball) const;
+
+    void PlanBallLayers(ThreadPool &pool, std::stop_token stop);
+
     // Table object
     ObjectLoader *table;
+    BallSystem ballSystem; // Physics state of the balls, stepped by Update()
     // Vector of ball models
     std::vector<glm::vec3> ballPositions; // Positions of the balls
     Renderer *renderer{nullptr}; // Renderer to use for drawing
+    TextureArray ballTextures; // One layer per distinct ball texture, bound once per frame
+    std::vector<std::string> ballLayerPaths; // Image file of each ballTextures layer
+    std::vector<int> ballLayers; // Layer of each ball's texture, -1 for none
+    int ballLayerWidth{0}, ballLayerHeight{0}; // Size of every ballTextures layer
+    GLenum ballLayerFormat{GL_RGBA8};
+    unsigned int loaderThreads{0}; // Worker threads for asset loading, 0 = hardware threads
+    int ballSegments{0}; // Tessellation of generated ball spheres, 0 = load the OBJ geometry
+    bool continuousCollisions{false}; // Sweep balls through each step instead of fixing overlaps afterwards
 };
 
 #endif //BILLIARDSHOW_SCENE_H
@@ -0,0 +1,303 @@
+/**
+ * @file ShotSolver.cpp
+ * @brief Implementation of the ShotSolver class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "ShotSolver.h"
+#include "BallSystem.h"
+#include "Constants.h"
+#include "../Utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+static constexpr double RADIUS = Constants::BALL_RADIUS;
+// Speed lost per second; the stepped simulation takes friction and rolling friction off the speed in turn
+static constexpr double DECELERATION = (double) Constants::BALL_FRICTION + Constants::BALL_ROLLING_FRICTION;
+// Range of ball centres inside the cushions
+static constexpr double MIN_X = -Constants::PLAY_LENGTH / 2.0 + RADIUS;
+static constexpr double MAX_X = Constants::PLAY_LENGTH / 2.0 - RADIUS;
+static constexpr double MIN_Z = -Constants::PLAY_WIDTH / 2.0 + RADIUS;
+static constexpr double MAX_Z = Constants::PLAY_WIDTH / 2.0 - RADIUS;
+static constexpr double MIN_SPEED = 0.0001; // Below this a ball counts as still, m/s, as in BallSystem
+static constexpr double NEVER = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Evaluates the polynomial c[0] + c[1] x + ... + c[degree] x^degree.
+ */
+static double evaluate(const double *c, int degree, double x) {
+    double result = c[degree];
+    for (int k = degree - 1; k >= 0; --k) result = result * x + c[k];
+    return result;
+}
+
+/**
+ * @brief Finds the real roots of a polynomial of degree at most 4 in [lo, hi], in ascending order.
+ * Quadratics are solved in closed form. Above that, between consecutive roots of the derivative
+ * the polynomial is monotonic, so recursing on the derivative splits the interval into pieces
+ * holding at most one root each, found by safeguarded Newton iteration.
+ * @param c Coefficients, constant term first.
+ * @return Number of roots written to roots.
+ */
+static int realRoots(const double *c, int degree, double lo, double hi, double *roots) {
+    while (degree > 0 && c[degree] == 0.0) --degree;
+    if (degree == 0) return 0;
+    if (degree == 1) {
+        const double root = -c[0] / c[1];
+        if (root < lo || root > hi) return 0;
+        roots[0] = root;
+        return 1;
+    }
+    if (degree == 2) {
+        const double discriminant = c[1] * c[1] - 4 * c[2] * c[0];
+        if (discriminant < 0.0) return 0;
+        // Computes the larger-magnitude root first and the other from their product, avoiding cancellation
+        const double q = -0.5 * (c[1] + std::copysign(std::sqrt(discriminant), c[1]));
+        double first = q / c[2], second = q != 0.0 ? c[0] / q : first;
+        if (first > second) std::swap(first, second);
+        int count = 0;
+        if (first >= lo && first <= hi) roots[count++] = first;
+        if (second >= lo && second <= hi && (count == 0 || second > first)) roots[count++] = second;
+        return count;
+    }
+    double derivative[4];
+    for (int k = 1; k <= degree; ++k) derivative[k - 1] = k * c[k];
+    double bounds[6];
+    bounds[0] = lo;
+    int boundCount = 1 + realRoots(derivative, degree - 1, lo, hi, bounds + 1);
+    bounds[boundCount++] = hi;
+    int count = 0;
+    for (int k = 0; k + 1 < boundCount; ++k) {
+        double a = bounds[k], b = bounds[k + 1];
+        const double fa = evaluate(c, degree, a);
+        const double fb = evaluate(c, degree, b);
+        if (fa != 0.0 && fb != 0.0 && (fa < 0.0) == (fb < 0.0)) continue;
+        double root = fa == 0.0 ? a : b;
+        if (fa != 0.0 && fb != 0.0) {
+            // Newton's method, falling back to bisection whenever a step leaves the bracket
+            root = 0.5 * (a + b);
+            for (int iteration = 0; iteration < 100; ++iteration) {
+                const double value = evaluate(c, degree, root);
+                if (value == 0.0) break;
+                if ((value < 0.0) == (fa < 0.0)) a = root;
+                else b = root;
+                double next = root - value / evaluate(derivative, degree - 1, root);
+                if (!(next > a && next < b)) next = 0.5 * (a + b);
+                if (std::fabs(next - root) <= 1e-15 * (1.0 + std::fabs(root))) break;
+                root = next;
+            }
+        }
+        if (count == 0 || root > roots[count - 1]) roots[count++] = root;
+    }
+    return count;
+}
+
+/**
+ * @brief Gets the first s in [0, length] where a polynomial crosses zero in the given direction
+ * (+1 rising, -1 falling), or -1 if it does not. Also returns 0 when the polynomial is already
+ * at or past zero at s = 0 and still moving that way.
+ */
+static double firstCrossing(const double *c, int degree, double length, double direction) {
+    double derivative[4];
+    for (int k = 1; k <= degree; ++k) derivative[k - 1] = k * c[k];
+    if (c[0] * direction >= 0.0 && derivative[0] * direction > 0.0) return 0.0;
+    double roots[4];
+    const int count = realRoots(c, degree, 0.0, length, roots);
+    for (int k = 0; k < count; ++k)
+        if (evaluate(derivative, degree - 1, roots[k]) * direction > 0.0) return roots[k];
+    return -1.0;
+}
+
+void ShotSolver::Load(const BallSystem &system) {
+    balls.clear();
+    events.clear();
+    queue = {};
+    now = 0.0;
+    for (int i = 0; i < system.GetCount(); ++i) Add(system.GetPosition(i), system.GetVelocity(i));
+}
+
+int ShotSolver::Add(const glm::vec3 &position, const glm::vec3 &velocity) {
+    balls.emplace_back();
+    balls.back().y = position.y;
+    const int i = (int) balls.size() - 1;
+    SetMotion(i, glm::dvec2(position.x, position.z), glm::dvec2(velocity.x, velocity.z));
+    return i;
+}
+
+glm::vec3 ShotSolver::GetPosition(int i) const {
+    glm::dvec2 position, velocity, acceleration;
+    State(i, now, position, velocity, acceleration);
+    return {(float) position.x, (float) balls[i].y, (float) position.y};
+}
+
+/**
+ * @fn Store
+ * @brief Also records the new state as the previous one, so rendering does not slide the balls there.
+ */
+void ShotSolver::Store(BallSystem &system) const {
+    for (int i = 0; i < (int) balls.size() && i < system.GetCount(); ++i) {
+        system.SetPosition(i, GetPosition(i));
+        system.SetVelocity(i, glm::vec3(0.0f));
+        system.SetAngularVelocity(i, glm::vec3(0.0f));
+    }
+    system.SaveState();
+}
+
+/**
+ * @fn State
+ * @brief Evaluates a ball's motion at a time at or after its start.
+ */
+void ShotSolver::State(int i, double time, glm::dvec2 &outPosition, glm::dvec2 &outVelocity,
+                       glm::dvec2 &outAcceleration) const {
+    const Motion &motion = balls[i];
+    // Compared in absolute time, as PredictBall() splits its pieces, so both agree when the ball stops
+    const bool moving = time < motion.start + motion.duration;
+    const double t = moving ? std::max(time - motion.start, 0.0) : motion.duration;
+    outPosition = motion.position + motion.velocity * t + motion.acceleration * (0.5 * t * t);
+    outVelocity = moving ? motion.velocity + motion.acceleration * t : glm::dvec2(0.0);
+    outAcceleration = moving ? motion.acceleration : glm::dvec2(0.0);
+}
+
+/**
+ * @fn SetMotion
+ * @brief Starts a new motion for a ball at the current time, invalidating its predicted events.
+ */
+void ShotSolver::SetMotion(int i, const glm::dvec2 &position, const glm::dvec2 &velocity) {
+    Motion &motion = balls[i];
+    const double speed = glm::length(velocity);
+    motion.position = position;
+    motion.velocity = speed > 0.0 ? velocity : glm::dvec2(0.0);
+    motion.acceleration = speed > 0.0 ? velocity * (-DECELERATION / speed) : glm::dvec2(0.0);
+    motion.start = now;
+    motion.duration = speed / DECELERATION;
+    PredictCushion(motion);
+    ++motion.version;
+}
+
+/**
+ * @fn PredictBall
+ * @brief Gets the time two balls next touch while approaching, or infinity.
+ * Only looks as far as the first cushion either ball reaches, since its motion changes there and
+ * the pair is predicted again. Until then the gap between the centres is a quadratic curve in time,
+ * changing when one ball stops, so its squared length minus the squared contact distance is a
+ * quartic per piece.
+ */
+double ShotSolver::PredictBall(int a, int b) const {
+    const double horizon = std::min(balls[a].cushion, balls[b].cushion);
+    glm::dvec2 pa, va, aa, pb, vb, ab;
+    double time = now;
+    while (time < horizon) {
+        const double endA = balls[a].start + balls[a].duration;
+        const double endB = balls[b].start + balls[b].duration;
+        const double end = std::min({endA > time ? endA : NEVER, endB > time ? endB : NEVER, horizon});
+        if (end == NEVER) break; // Both at rest
+        State(a, time, pa, va, aa);
+        State(b, time, pb, vb, ab);
+        const glm::dvec2 dp = pb - pa;
+        const glm::dvec2 dv = vb - va;
+        const glm::dvec2 da = (ab - aa) * 0.5;
+        // Cheap rejection: the gap is dp + dv s + da s^2, so it stays wider than the contact distance if
+        // its straight part does by more than the curved part can close within the piece
+        const double length = end - time;
+        const double approach = glm::dot(dv, dv);
+        const double closest = approach > 0.0 ? std::clamp(-glm::dot(dp, dv) / approach, 0.0, length) : 0.0;
+        if (glm::length(dp + dv * closest) - glm::length(da) * length * length > 2 * RADIUS) {
+            time = end;
+            continue;
+        }
+        const double c[5] = {glm::dot(dp, dp) - 4 * RADIUS * RADIUS, 2 * glm::dot(dp, dv),
+                             glm::dot(dv, dv) + 2 * glm::dot(dp, da), 2 * glm::dot(dv, da), glm::dot(da, da)};
+        const double s = firstCrossing(c, 4, length, -1.0);
+        if (s >= 0.0) return time + s;
+        time = end;
+    }
+    return NEVER;
+}
+
+/**
+ * @fn PredictCushion
+ * @brief Sets when a new motion first reaches a cushion line while moving toward it.
+ */
+void ShotSolver::PredictCushion(Motion &motion) const {
+    const double limits[2][2] = {{MIN_X, MAX_X}, {MIN_Z, MAX_Z}};
+    motion.cushion = NEVER;
+    for (int axis = 0; axis < 2; ++axis) {
+        for (int side = 0; side < 2; ++side) {
+            const double c[3] = {motion.position[axis] - limits[axis][side], motion.velocity[axis],
+                                 0.5 * motion.acceleration[axis]};
+            const double s = firstCrossing(c, 2, motion.duration, side == 0 ? -1.0 : 1.0);
+            if (s >= 0.0 && motion.start + s < motion.cushion) {
+                motion.cushion = motion.start + s;
+                motion.axis = axis;
+            }
+        }
+    }
+}
+
+/**
+ * @fn Predict
+ * @brief Queues the next events of a ball: its stop, its next cushion and its next contact with
+ * each other ball. Pairs it does not move in are left to the other ball's predictions.
+ */
+void ShotSolver::Predict(int i) {
+    const Motion &motion = balls[i];
+    if (motion.duration <= 0.0) return;
+    queue.push({{Event::REST, motion.start + motion.duration, i, -1}, motion.version, motion.version});
+    if (motion.cushion < NEVER) queue.push({{Event::CUSHION, motion.cushion, i, -1}, motion.version, motion.version});
+    for (int other = 0; other < (int) balls.size(); ++other) {
+        if (other == i) continue;
+        const double contact = PredictBall(i, other);
+        if (contact < NEVER)
+            queue.push({{Event::BALL, contact, i, other}, motion.version, balls[other].version});
+    }
+}
+
+/**
+ * @fn Solve
+ * @brief Processes events in time order, skipping those predicted for motions that have changed.
+ * Collisions and cushions respond as in BallSystem: equal-mass elastic exchange along the line of
+ * centres, and reflection of the velocity component into the cushion.
+ */
+bool ShotSolver::Solve(int maxEvents) {
+    queue = {};
+    for (int i = 0; i < (int) balls.size(); ++i) Predict(i);
+    int processed = 0;
+    while (!queue.empty()) {
+        const Pending next = queue.top();
+        queue.pop();
+        const Event &event = next.event;
+        if (balls[event.a].version != next.versionA) continue;
+        if (event.b >= 0 && balls[event.b].version != next.versionB) continue;
+        if (processed++ == maxEvents) {
+            Logger::Warn("Shot not settled after " + std::to_string(maxEvents) + " events");
+            return false;
+        }
+        now = event.time;
+        events.push_back(event);
+        if (event.type == Event::REST) continue; // The motion already ends here
+        glm::dvec2 pa, va, acc;
+        State(event.a, now, pa, va, acc);
+        if (event.type == Event::CUSHION) {
+            va[balls[event.a].axis] = -va[balls[event.a].axis];
+            SetMotion(event.a, pa, va);
+            Predict(event.a);
+            continue;
+        }
+        glm::dvec2 pb, vb;
+        State(event.b, now, pb, vb, acc);
+        const glm::dvec2 normal = glm::normalize(pb - pa);
+        // Balls meeting slower than MIN_SPEED part at MIN_SPEED, so a contact rounding leaves closing
+        // is not found again at the same time
+        const double closing = glm::dot(vb - va, normal);
+        const double exchange = std::min(closing, 0.5 * (closing - MIN_SPEED));
+        SetMotion(event.a, pa, va + normal * exchange);
+        SetMotion(event.b, pb, vb - normal * exchange);
+        Predict(event.a);
+        Predict(event.b);
+    }
+    return true;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file ShotSolver.h
+ * @brief Header file for the ShotSolver class.
+ * Solves a shot without stepping: every ball's motion between events has a closed form, so the
+ * solver computes when the next collision, cushion hit or stop happens and jumps straight to it,
+ * until every ball is at rest. Meant for evaluating shots headless, where only the final layout
+ * and the sequence of events matter.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_SHOTSOLVER_H
+#define BILLIARDSHOW_SHOTSOLVER_H
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+class BallSystem;
+
+/**
+ * @class ShotSolver
+ * @brief Event-driven solver for balls rolling on the table until they stop.
+ * Uses the friction model of the stepped simulation: sliding and rolling friction both take a
+ * fixed amount of speed per second, so a ball decelerates uniformly along a straight line and
+ * stops after speed / (BALL_FRICTION + BALL_ROLLING_FRICTION) seconds. Balls move in the table
+ * plane; collisions between balls and with the cushions are handled as by BallSystem.
+ * Contact times are roots of the polynomials of the motion, found to double precision, and kept
+ * in a priority queue. When a ball's motion changes, its queued events are dropped and only its
+ * own next events are computed again.
+ */
+class ShotSolver {
+public:
+    /**
+     * @struct Event
+     * @brief Something that happened during the shot.
+     */
+    struct Event {
+        enum Type { BALL, CUSHION, REST };
+
+        Type type;
+        double time; // Seconds since the start of the shot
+        int a;       // Ball the event happened to
+        int b;       // The other ball of a BALL event, -1 otherwise
+    };
+
+    /**
+     * @brief Takes the positions and velocities of all balls of a ball system as the start of the shot.
+     * Heights and vertical velocities are ignored.
+     */
+    void Load(const BallSystem &balls);
+
+    /**
+     * @brief Adds a ball to the start of the shot.
+     * @param position Position on the table; y is ignored.
+     * @param velocity Velocity; y is ignored.
+     * @return Index of the ball.
+     */
+    int Add(const glm::vec3 &position, const glm::vec3 &velocity);
+
+    /**
+     * @brief Runs the shot until every ball is at rest.
+     * @param maxEvents Most events to process, a guard against shots that never settle.
+     * @return False if the limit was reached first; the balls are then left where that event was.
+     */
+    bool Solve(int maxEvents = 100000);
+
+    /**
+     * @brief Gets where a ball is at the current time: at rest after a successful Solve().
+     */
+    glm::vec3 GetPosition(int i) const;
+
+    /**
+     * @brief Gets the time the last ball came to rest, in seconds since the start of the shot.
+     */
+    double GetTime() const { return now; }
+
+    /**
+     * @brief Gets the events of the shot in the order they happened.
+     */
+    const std::vector<Event> &GetEvents() const { return events; }
+
+    /**
+     * @brief Writes the final positions into a ball system and stops its balls.
+     * The system must hold the same balls, in the same order, as when loaded.
+     */
+    void Store(BallSystem &balls) const;
+
+private:
+    /**
+     * @struct Motion
+     * @brief Straight-line uniformly decelerated motion that started at some time.
+     */
+    struct Motion {
+        glm::dvec2 position{0.0};     // (x, z) at start
+        glm::dvec2 velocity{0.0};     // At start
+        glm::dvec2 acceleration{0.0}; // Friction, against the velocity until the ball stops
+        double start = 0.0;           // Time the motion started
+        double duration = 0.0;        // Time from start until the ball stops, 0 at rest
+        double cushion = 0.0;         // Time the ball next reaches a cushion, infinity if it stops first
+        int axis = 0;                 // Of that cushion: 0 for the x cushions, 1 for the z cushions
+        double y = 0.0;               // Height, kept for GetPosition()
+        uint32_t version = 0;         // Counts changes, to recognize events predicted for an older motion
+    };
+
+    /**
+     * @struct Pending
+     * @brief A predicted event, valid while the balls it involves keep the motion it was computed for.
+     */
+    struct Pending {
+        Event event;
+        uint32_t versionA;
+        uint32_t versionB;
+
+        bool operator>(const Pending &other) const { return event.time > other.event.time; }
+    };
+
+    void State(int i, double time, glm::dvec2 &outPosition, glm::dvec2 &outVelocity, glm::dvec2 &outAcceleration) const;
+
+    void SetMotion(int i, const glm::dvec2 &position, const glm::dvec2 &velocity);
+
+    void Predict(int i);
+
+    double PredictBall(int a, int b) const;
+
+    void PredictCushion(Motion &motion) const;
+
+    std::vector<Motion> balls;
+    std::vector<Event> events;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> queue;
+    double now = 0.0;
+};
+
+#endif //BILLIARDSHOW_SHOTSOLVER_H
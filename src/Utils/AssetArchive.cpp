@@ -0,0 +1,158 @@
+/**
+ * @file AssetArchive.cpp
+ * @brief Implementation of the AssetArchive and AssetFile classes.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "AssetArchive.h"
+#include "AssetPrefetcher.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <filesystem>
+
+AssetArchive &AssetArchive::Instance() {
+    static AssetArchive instance;
+    return instance;
+}
+
+/**
+ * @fn Mount
+ * @brief Maps an archive and validates every table of contents entry against the mapped size,
+ * so lookups never have to check bounds again.
+ */
+bool AssetArchive::Mount(const std::string &path) {
+    Unmount();
+    if (!file.Open(path)) return false;
+    const uint64_t size = file.Size();
+    const auto *h = reinterpret_cast<const Header *>(file.Data());
+    if (size < sizeof(Header) || h->magic != MAGIC || h->version != VERSION || h->entrySize != sizeof(Entry)) {
+        Logger::Warn("Ignoring asset archive with unknown format: " + path);
+        file.Close();
+        return false;
+    }
+    if (h->archiveSize != size || h->tocOffset + uint64_t(h->entryCount) * sizeof(Entry) > size ||
+        h->namesOffset + h->namesSize > size) {
+        Logger::Warn("Ignoring truncated asset archive: " + path);
+        file.Close();
+        return false;
+    }
+    const auto *toc = reinterpret_cast<const Entry *>(file.Data() + h->tocOffset);
+    const char *strings = file.Data() + h->namesOffset;
+    std::string_view previous;
+    for (uint32_t i = 0; i < h->entryCount; ++i) {
+        const Entry &e = toc[i];
+        if (e.dataOffset + e.size > size || uint64_t(e.nameOffset) + e.nameLength > h->namesSize) {
+            Logger::Warn("Ignoring asset archive with an invalid entry: " + path);
+            file.Close();
+            return false;
+        }
+        std::string_view name(strings + e.nameOffset, e.nameLength);
+        if (i > 0 && !(previous < name)) {
+            Logger::Warn("Ignoring asset archive with an unsorted table of contents: " + path);
+            file.Close();
+            return false;
+        }
+        previous = name;
+    }
+    header = h;
+    entries = toc;
+    names = strings;
+    Logger::Info("Mounted asset archive " + path + ": " + std::to_string(h->entryCount) + " files, " +
+                 std::to_string(size) + " bytes");
+    return true;
+}
+
+/**
+ * @fn Unmount
+ * @brief Unmaps the archive.
+ */
+void AssetArchive::Unmount() {
+    header = nullptr;
+    entries = nullptr;
+    names = nullptr;
+    file.Close();
+}
+
+std::string_view AssetArchive::NameOf(const Entry &entry) const {
+    return {names + entry.nameOffset, entry.nameLength};
+}
+
+/**
+ * @fn FindEntry
+ * @brief Binary searches the sorted table of contents.
+ */
+const AssetArchive::Entry *AssetArchive::FindEntry(std::string_view path) const {
+    if (!header) return nullptr;
+    const std::string key = NormalizePath(path);
+    const Entry *end = entries + header->entryCount;
+    const Entry *it = std::lower_bound(entries, end, std::string_view(key), [this](const Entry &e, std::string_view k) {
+        return NameOf(e) < k;
+    });
+    return it != end && NameOf(*it) == key ? it : nullptr;
+}
+
+bool AssetArchive::Find(std::string_view path, std::span<const std::byte> &outData) const {
+    const Entry *e = FindEntry(path);
+    if (!e) return false;
+    outData = {reinterpret_cast<const std::byte *>(file.Data() + e->dataOffset), static_cast<size_t>(e->size)};
+    return true;
+}
+
+bool AssetArchive::Stat(std::string_view path, uint64_t &outSize) const {
+    const Entry *e = FindEntry(path);
+    if (!e) return false;
+    outSize = e->size;
+    return true;
+}
+
+/**
+ * @fn NormalizePath
+ * @brief Converts backslashes to slashes and drops "." segments and repeated slashes.
+ */
+std::string AssetArchive::NormalizePath(std::string_view path) {
+    std::string out;
+    out.reserve(path.size());
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find_first_of("/\\", start);
+        if (end == std::string_view::npos) end = path.size();
+        std::string_view segment = path.substr(start, end - start);
+        if (!segment.empty() && segment != ".") {
+            if (!out.empty()) out += '/';
+            out += segment;
+        }
+        start = end + 1;
+    }
+    return out;
+}
+
+/**
+ * @fn Open
+ * @brief Opens an asset from the mounted archive, or else from the prefetched loose files, or maps the loose file.
+ */
+bool AssetFile::Open(const std::string &path) {
+    mapping.Close();
+    prefetched.reset();
+    bytes = {};
+    open = AssetArchive::Instance().Find(path, bytes) || AssetPrefetcher::Instance().Find(path, bytes, prefetched);
+    if (!open && mapping.Open(path)) {
+        bytes = {reinterpret_cast<const std::byte *>(mapping.Data()), mapping.Size()};
+        open = true;
+    }
+    return open;
+}
+
+/**
+ * @fn Stat
+ * @brief Gets the size of an asset, from the archive or the file system.
+ */
+bool AssetFile::Stat(const std::string &path, uint64_t &outSize) {
+    if (AssetArchive::Instance().Stat(path, outSize)) return true;
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    outSize = static_cast<uint64_t>(size);
+    return true;
+}
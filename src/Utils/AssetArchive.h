@@ -0,0 +1,156 @@
+/**
+ * @file AssetArchive.h
+ * @brief Header file for the AssetArchive and AssetFile classes.
+ * An asset archive packs every file the app reads at startup into one file: a header, a table of
+ * contents sorted by path, the path strings, and the file contents, each starting on an aligned
+ * offset. The archive is memory mapped once and hands out views into the mapping, so loading
+ * assets costs one open and one mmap instead of an open/read sequence per file.
+ * Archives are built by tools/AssetPacker.cpp.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_ASSETARCHIVE_H
+#define BILLIARDSHOW_ASSETARCHIVE_H
+
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @class AssetArchive
+ * @brief Read-only view of a mounted asset archive.
+ * Entries are looked up by their path relative to the working directory, exactly as the loaders
+ * name them (e.g. "assets/objects/PoolBalluv1.obj"). Mount the archive before any loader thread
+ * starts; after that all lookups are thread-safe.
+ */
+class AssetArchive {
+public:
+    static constexpr uint32_t MAGIC = 0x4B505342; // "BSPK" in little-endian byte order
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t ALIGNMENT = 64;       // Table and file contents start on cache line boundaries
+
+    /**
+     * @struct Header
+     * @brief On-disk header; all offsets are in bytes from the start of the archive.
+     */
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t entrySize;   // sizeof(Entry), checked on open
+        uint64_t tocOffset;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+        uint64_t archiveSize;
+    };
+
+    /**
+     * @struct Entry
+     * @brief Table of contents entry; entries are sorted by path.
+     */
+    struct Entry {
+        uint64_t dataOffset;
+        uint64_t size;
+        uint32_t nameOffset;  // Path, relative to the names block, not null-terminated
+        uint32_t nameLength;
+    };
+
+    /**
+     * @brief Gets the process-wide archive.
+     */
+    static AssetArchive &Instance();
+
+    /**
+     * @brief Maps an archive and validates its table of contents.
+     * @param path The path to the archive.
+     * @return True if the archive was mounted; false if it is missing or invalid, in which case
+     * all assets are read from loose files.
+     */
+    bool Mount(const std::string &path);
+
+    /**
+     * @brief Unmaps the archive. Views handed out before are invalidated.
+     */
+    void Unmount();
+
+    bool IsMounted() const { return header != nullptr; }
+
+    size_t GetEntryCount() const { return header ? header->entryCount : 0; }
+
+    /**
+     * @brief Finds a packed file.
+     * @param path Path of the file as the loaders name it.
+     * @param outData Receives a view of the file contents, valid while the archive is mounted.
+     * @return True if the archive is mounted and contains the file.
+     */
+    bool Find(std::string_view path, std::span<const std::byte> &outData) const;
+
+    /**
+     * @brief Gets the size of a packed file.
+     * @return True if the archive is mounted and contains the file.
+     */
+    bool Stat(std::string_view path, uint64_t &outSize) const;
+
+    /**
+     * @brief Brings a path into the form used as archive key: forward slashes, no "./" segments.
+     */
+    static std::string NormalizePath(std::string_view path);
+
+private:
+    AssetArchive() = default;
+
+    const Entry *FindEntry(std::string_view path) const;
+
+    std::string_view NameOf(const Entry &entry) const;
+
+    MappedFile file;
+    const Header *header = nullptr;
+    const Entry *entries = nullptr;
+    const char *names = nullptr;
+};
+
+/**
+ * @class AssetFile
+ * @brief The contents of one asset, from the mounted archive or else from a loose file.
+ * Loose files that the AssetPrefetcher has read ahead are served from its buffer; other loose
+ * files are memory mapped, so every source is read the same way and without copying.
+ */
+class AssetFile {
+public:
+    /**
+     * @brief Opens an asset, preferring the mounted archive, then the prefetched files, then the file system.
+     * @param path The path to the asset.
+     * @return True if the asset was found.
+     */
+    bool Open(const std::string &path);
+
+    std::span<const std::byte> Bytes() const { return bytes; }
+
+    const char *Data() const { return reinterpret_cast<const char *>(bytes.data()); }
+
+    size_t Size() const { return bytes.size(); }
+
+    bool IsOpen() const { return open; }
+
+    /**
+     * @brief Gets the size of an asset, from the archive or the file system, without reading it.
+     * @return False if the asset does not exist.
+     */
+    static bool Stat(const std::string &path, uint64_t &outSize);
+
+private:
+    MappedFile mapping;
+    std::shared_ptr<const std::byte[]> prefetched; // Keeps a prefetched buffer alive while it is viewed
+    std::span<const std::byte> bytes;
+    bool open = false;
+};
+
+#endif //BILLIARDSHOW_ASSETARCHIVE_H
@@ -0,0 +1,456 @@
+/**
+ * @file AssetPrefetcher.cpp
+ * @brief Implementation of the AssetPrefetcher class.
+ * io_uring is driven through its raw system calls, so no liburing is needed.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "AssetPrefetcher.h"
+#include "AssetArchive.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define BILLIARDSHOW_IO_URING 1
+#include <atomic>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
+#endif
+#endif
+
+// Largest single read; bigger files are read in several requests
+static constexpr uint64_t MAX_READ_BYTES = 1ull << 30;
+// Most reads in flight at once
+static constexpr unsigned MAX_QUEUE_DEPTH = 256;
+
+#ifdef BILLIARDSHOW_IO_URING
+
+/**
+ * @class IoUring
+ * @brief Minimal io_uring instance: one submission and one completion ring, set up with raw syscalls.
+ */
+class IoUring {
+public:
+    ~IoUring() {
+        if (sqRing != MAP_FAILED && sqRing) munmap(sqRing, sqRingSize);
+        if (cqRing != MAP_FAILED && cqRing && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqes != MAP_FAILED && sqes) munmap(sqes, sqesSize);
+        if (fd >= 0) close(fd);
+    }
+
+    /**
+     * @brief Creates the instance and maps its rings.
+     * @return False if the kernel has no io_uring or refuses it (e.g. blocked by seccomp).
+     */
+    bool Setup(unsigned entries) {
+        io_uring_params params = {};
+        fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) return false;
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) return false;
+        cqRing = singleMap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                           IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) return false;
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        auto *sq = static_cast<char *>(sqRing);
+        auto *cq = static_cast<char *>(cqRing);
+        sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        capacity = params.sq_entries;
+        return true;
+    }
+
+    unsigned Capacity() const { return capacity; }
+
+    /**
+     * @brief Queues a vectored read; becomes visible to the kernel with the next Enter().
+     */
+    void QueueRead(int file, const iovec *iov, uint64_t offset, uint64_t userData) {
+        const unsigned tail = *sqTail; // Only this thread writes the tail
+        io_uring_sqe &sqe = static_cast<io_uring_sqe *>(sqes)[tail & sqMask];
+        sqe = {};
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = file;
+        sqe.addr = reinterpret_cast<uint64_t>(iov);
+        sqe.len = 1;
+        sqe.off = offset;
+        sqe.user_data = userData;
+        sqArray[tail & sqMask] = tail & sqMask;
+        std::atomic_ref<unsigned>(*sqTail).store(tail + 1, std::memory_order_release);
+        ++queued;
+    }
+
+    /**
+     * @brief Submits the queued reads and waits until at least one completion is available.
+     * @return 0 on success, otherwise the errno of io_uring_enter.
+     */
+    int Enter() {
+        const int submitted = (int) syscall(__NR_io_uring_enter, fd, queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (submitted < 0) return errno;
+        queued -= std::min<unsigned>(queued, (unsigned) submitted);
+        return 0;
+    }
+
+    /**
+     * @brief Calls done(userData, result) for every available completion.
+     */
+    template<typename Done>
+    void Reap(const Done &done) {
+        unsigned head = *cqHead; // Only this thread writes the head
+        const unsigned tail = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            done(cqe.user_data, cqe.res);
+        }
+        std::atomic_ref<unsigned>(*cqHead).store(head, std::memory_order_release);
+    }
+
+private:
+    int fd = -1;
+    void *sqRing = nullptr;
+    void *cqRing = nullptr;
+    void *sqes = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqesSize = 0;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+    unsigned capacity = 0;
+    unsigned queued = 0; // Entries queued but not yet taken by the kernel
+};
+
+#endif
+
+AssetPrefetcher &AssetPrefetcher::Instance() {
+    static AssetPrefetcher instance;
+    return instance;
+}
+
+AssetPrefetcher::~AssetPrefetcher() {
+    Release();
+}
+
+/**
+ * @fn Start
+ * @brief Registers the files of a new batch and starts the reader thread.
+ * Files are opened and sized on the reader thread, so this returns without touching the disk.
+ */
+void AssetPrefetcher::Start(const std::vector<std::string> &paths, Expand expandFunction) {
+    Release();
+    std::lock_guard<std::mutex> lock(mutex);
+    expand = std::move(expandFunction);
+    added.clear();
+    for (const auto &path: paths) {
+        std::string key = AssetArchive::NormalizePath(path);
+        if (index.count(key)) continue;
+        index.emplace(key, requests.size());
+        requests.emplace_back().path = path;
+    }
+    if (requests.empty()) return;
+    thread = std::jthread([this](std::stop_token stop) { Run(stop); });
+}
+
+/**
+ * @fn Find
+ * @brief Waits for a file of the batch and shares its buffer.
+ */
+bool AssetPrefetcher::Find(std::string_view path, std::span<const std::byte> &outData,
+                           std::shared_ptr<const std::byte[]> &outOwner) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (index.empty()) return false;
+    auto it = index.find(AssetArchive::NormalizePath(path));
+    if (it == index.end()) return false;
+    const size_t i = it->second;
+    const uint64_t batch = generation;
+    finished.wait(lock, [&]() { return generation != batch || requests[i].state != Request::PENDING; });
+    if (generation != batch || requests[i].state != Request::READY) return false;
+    const Request &request = requests[i];
+    outData = {request.buffer.get(), (size_t) request.size};
+    outOwner = request.buffer;
+    return true;
+}
+
+/**
+ * @fn Release
+ * @brief Stops the reader thread, which finishes its reads in flight, and drops the batch.
+ */
+void AssetPrefetcher::Release() {
+    if (thread.joinable()) {
+        thread.request_stop();
+        thread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.clear();
+        index.clear();
+        ++generation;
+    }
+    finished.notify_all();
+}
+
+/**
+ * @fn Finish
+ * @brief Publishes the outcome of one read and wakes the threads waiting for files.
+ * The files a completed file refers to join the batch in the same step, so a loader that opens one
+ * of them after reading the file finds it queued.
+ */
+void AssetPrefetcher::Finish(size_t i, bool ok) {
+    std::vector<std::string> referenced;
+    if (ok && expand) expand(requests[i].path, {requests[i].buffer.get(), (size_t) requests[i].size}, referenced);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests[i].state = ok ? Request::READY : Request::FAILED;
+        if (!ok) requests[i].buffer.reset();
+        for (const auto &path: referenced) {
+            std::string key = AssetArchive::NormalizePath(path);
+            if (index.count(key)) continue;
+            index.emplace(key, requests.size());
+            added.push_back(requests.size());
+            requests.emplace_back().path = path;
+        }
+    }
+    finished.notify_all();
+}
+
+/**
+ * @fn Prepare
+ * @brief Opens and sizes a file and allocates its buffer.
+ * Empty and missing files are failed right away, so AssetFile falls back to the file system for them.
+ * @return True if the file is ready to be read.
+ */
+bool AssetPrefetcher::Prepare(size_t i) {
+    Request &request = requests[i];
+#ifdef __linux__
+    request.fd = open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info = {};
+    if (request.fd >= 0 && fstat(request.fd, &info) == 0) request.size = (uint64_t) info.st_size;
+#else
+    std::error_code ec;
+    request.size = std::filesystem::file_size(request.path, ec);
+    if (ec) request.size = 0;
+#endif
+    if (request.size > 0) request.buffer.reset(new(std::nothrow) std::byte[request.size]);
+    if (!request.buffer) {
+        Finish(i, false);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @fn TakeAdded
+ * @brief Prepares the files that joined the batch since the last call.
+ * After a stop request they are failed instead of opened.
+ * @return The ones ready to be read.
+ */
+std::vector<size_t> AssetPrefetcher::TakeAdded(std::stop_token stop) {
+    std::vector<size_t> ready;
+    while (!added.empty()) {
+        std::vector<size_t> batch;
+        batch.swap(added);
+        for (size_t i: batch) {
+            if (stop.stop_requested()) Finish(i, false);
+            else if (Prepare(i)) ready.push_back(i);
+        }
+    }
+    return ready;
+}
+
+/**
+ * @fn Run
+ * @brief Opens and sizes every file, allocates its buffer, then reads the batch.
+ * io_uring reads everything it can; whatever it could not take is read with plain reads. Files
+ * added by the expand function are read by whichever of the two is running when they arrive.
+ */
+void AssetPrefetcher::Run(std::stop_token stop) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < requests.size(); ++i)
+        if (Prepare(i)) pending.push_back(i);
+
+#ifdef BILLIARDSHOW_IO_URING
+    RunIoUring(stop, pending);
+#endif
+    RunPlainReads(stop, pending);
+
+    size_t fileCount = 0;
+    uint64_t totalBytes = 0;
+    for (auto &request: requests) {
+#ifdef __linux__
+        if (request.fd >= 0) close(request.fd);
+        request.fd = -1;
+#endif
+        if (request.state != Request::READY) continue;
+        ++fileCount;
+        totalBytes += request.size;
+    }
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    Logger::Info("Prefetched " + std::to_string(fileCount) + " asset files (" + std::to_string(totalBytes >> 10) +
+                 " KB) in " + std::to_string(ms.count()) + " ms");
+}
+
+#ifdef BILLIARDSHOW_IO_URING
+
+/**
+ * @fn RunIoUring
+ * @brief Reads the pending files through io_uring, with up to MAX_QUEUE_DEPTH reads in flight.
+ * All reads are submitted with one io_uring_enter and refilled as completions arrive. Short reads
+ * continue where they stopped. Files the kernel cannot read this way (old kernels without READV
+ * support) are left in pending for the plain reads; every other file is finished here.
+ */
+void AssetPrefetcher::RunIoUring(std::stop_token stop, std::vector<size_t> &pending) {
+    if (pending.empty()) return;
+    IoUring ring;
+    unsigned depth = 1;
+    while (depth < std::min<size_t>(pending.size(), MAX_QUEUE_DEPTH)) depth <<= 1;
+    if (!ring.Setup(depth)) {
+        Logger::Info("io_uring is unavailable (" + std::string(strerror(errno)) + "), prefetching with plain reads");
+        return;
+    }
+    Logger::Info("Prefetching " + std::to_string(pending.size()) + " asset files with io_uring");
+
+    std::deque<iovec> iovs(requests.size()); // Grows with the batch without moving the entries the kernel reads
+    std::vector<bool> submitted(requests.size(), false);
+    std::deque<size_t> work(pending.begin(), pending.end());
+    std::vector<size_t> unsupported;
+    unsigned inFlight = 0;
+    const auto complete = [&](uint64_t userData, int result) {
+        const size_t i = (size_t) userData;
+        Request &request = requests[i]; // Not used after Finish(), which may grow the batch
+        submitted[i] = false;
+        --inFlight;
+        if (result > 0) {
+            request.done += (uint64_t) result;
+            if (request.done < request.size) work.push_front(i);
+            else Finish(i, true);
+        } else if (result == -EINTR || result == -EAGAIN) {
+            work.push_front(i);
+        } else if (result == -EINVAL || result == -EOPNOTSUPP) {
+            unsupported.push_back(i);
+        } else {
+            // 0 means the file shrank since it was sized
+            Finish(i, false);
+        }
+    };
+    while (true) {
+        for (size_t i: TakeAdded(stop)) {
+            pending.push_back(i);
+            work.push_back(i);
+        }
+        iovs.resize(requests.size());
+        submitted.resize(requests.size(), false);
+        if (work.empty() && inFlight == 0) break;
+        if (stop.stop_requested()) {
+            for (size_t i: work) Finish(i, false);
+            work.clear();
+        }
+        while (!work.empty() && inFlight < ring.Capacity()) {
+            const size_t i = work.front();
+            work.pop_front();
+            Request &request = requests[i];
+            iovs[i].iov_base = request.buffer.get() + request.done;
+            iovs[i].iov_len = (size_t) std::min(request.size - request.done, MAX_READ_BYTES);
+            ring.QueueRead(request.fd, &iovs[i], request.done, i);
+            submitted[i] = true;
+            ++inFlight;
+        }
+        if (inFlight == 0) break;
+        const int error = ring.Enter();
+        if (error == EINTR || error == EAGAIN || error == EBUSY) continue;
+        if (error != 0) {
+            Logger::Warn("io_uring_enter failed (" + std::string(strerror(error)) + "), finishing with plain reads");
+            ring.Reap(complete);
+            // Closing the ring does not wait for reads still in flight, so the kernel may yet write into
+            // their buffers. Those files are read again from the start into fresh buffers, and the old
+            // buffers are kept alive for good.
+            std::vector<size_t> left;
+            for (size_t i: pending) {
+                Request &request = requests[i];
+                if (request.state != Request::PENDING) continue;
+                if (submitted[i]) {
+                    abandoned.push_back(std::move(request.buffer));
+                    request.buffer.reset(new(std::nothrow) std::byte[request.size]);
+                    request.done = 0;
+                    if (!request.buffer) {
+                        Finish(i, false);
+                        continue;
+                    }
+                }
+                left.push_back(i);
+            }
+            pending = std::move(left);
+            return;
+        }
+        ring.Reap(complete);
+    }
+    pending = unsupported;
+}
+
+#endif
+
+/**
+ * @fn RunPlainReads
+ * @brief Reads the pending files one after another, in the order they were requested.
+ * Files added meanwhile are read after them.
+ */
+void AssetPrefetcher::RunPlainReads(std::stop_token stop, std::vector<size_t> &pending) {
+    for (size_t k = 0;; ++k) {
+        for (size_t i: TakeAdded(stop)) pending.push_back(i);
+        if (k >= pending.size()) break;
+        const size_t i = pending[k];
+        if (stop.stop_requested()) {
+            Finish(i, false);
+            continue;
+        }
+        Request &request = requests[i];
+        bool ok = true;
+#ifdef __linux__
+        while (ok && request.done < request.size) {
+            const ssize_t n = pread(request.fd, request.buffer.get() + request.done,
+                                    (size_t) std::min(request.size - request.done, MAX_READ_BYTES),
+                                    (off_t) request.done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) ok = false;
+            else request.done += (uint64_t) n;
+        }
+#else
+        std::ifstream in(request.path, std::ios::binary);
+        in.read(reinterpret_cast<char *>(request.buffer.get()), (std::streamsize) request.size);
+        ok = in && (uint64_t) in.gcount() == request.size;
+#endif
+        Finish(i, ok);
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file AssetPrefetcher.h
+ * @brief Header file for the AssetPrefetcher class.
+ * Reads the loose asset files a load is about to open in one batch, so the disk sees every request
+ * at once instead of one page fault at a time. On Linux the reads go through io_uring; elsewhere,
+ * or when the kernel refuses io_uring, they fall back to plain reads on a background thread.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_ASSETPREFETCHER_H
+#define BILLIARDSHOW_ASSETPREFETCHER_H
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class AssetPrefetcher
+ * @brief Reads a list of files into memory in the background and hands the buffers to AssetFile.
+ * Start() returns immediately. AssetFile::Open() asks the prefetcher for files the archive does
+ * not contain: a file of the batch is returned as soon as its read completes, waiting for it if
+ * needed, so loader threads start parsing and decoding whichever files arrive first. Files outside
+ * the batch, and files whose read failed, are mapped as usual.
+ * Files named inside other files (an OBJ's MTL, an MTL's texture) need not be known up front: an
+ * expand function run on the reader thread lists them as each file arrives, and they join the batch
+ * before that file is handed out.
+ */
+class AssetPrefetcher {
+public:
+    /**
+     * @brief Lists the files a file of the batch refers to; runs on the reader thread.
+     * Arguments: the path of the file, its contents, and the list to append the referenced paths to.
+     */
+    using Expand = std::function<void(const std::string &, std::span<const std::byte>, std::vector<std::string> &)>;
+
+    /**
+     * @brief Gets the process-wide prefetcher.
+     */
+    static AssetPrefetcher &Instance();
+
+    ~AssetPrefetcher();
+
+    /**
+     * @brief Starts reading files in the background, replacing any earlier batch.
+     * @param paths Files to read, most urgent first; missing files are skipped.
+     * @param expand Lists further files to read for each file that arrives; may be empty.
+     */
+    void Start(const std::vector<std::string> &paths, Expand expand = {});
+
+    /**
+     * @brief Gets the contents of a file of the batch, waiting for its read to complete.
+     * @param path Path of the file as the loaders name it.
+     * @param outData Receives a view of the contents.
+     * @param outOwner Receives shared ownership of the buffer; the view stays valid while it is held.
+     * @return False if the file is not part of the batch or could not be read.
+     */
+    bool Find(std::string_view path, std::span<const std::byte> &outData, std::shared_ptr<const std::byte[]> &outOwner);
+
+    /**
+     * @brief Waits for outstanding reads and drops the batch.
+     * Buffers still held by open AssetFile objects are freed when those close.
+     * Call once loading is done, so later opens (e.g. hot reloads) see the files on disk again.
+     */
+    void Release();
+
+private:
+    /**
+     * @struct Request
+     * @brief One file of the batch.
+     */
+    struct Request {
+        enum State { PENDING, READY, FAILED };
+
+        std::string path;
+        int fd = -1;        // Linux only
+        uint64_t size = 0;
+        uint64_t done = 0;  // Bytes read so far; only touched by the reader thread
+        std::shared_ptr<std::byte[]> buffer;
+        State state = PENDING;
+    };
+
+    AssetPrefetcher() = default;
+
+    void Run(std::stop_token stop);
+
+    bool Prepare(size_t index);
+
+    std::vector<size_t> TakeAdded(std::stop_token stop);
+
+    void RunIoUring(std::stop_token stop, std::vector<size_t> &pending);
+
+    void RunPlainReads(std::stop_token stop, std::vector<size_t> &pending);
+
+    void Finish(size_t index, bool ok);
+
+    std::vector<Request> requests; // Only grows on the reader thread, under the mutex
+    Expand expand;
+    std::vector<size_t> added; // Requests appended by expand and not opened yet; reader thread only
+    std::vector<std::shared_ptr<std::byte[]>> abandoned; // Buffers an aborted io_uring batch may still write to
+    std::unordered_map<std::string, size_t> index; // Normalized path -> request
+    uint64_t generation = 0; // Counts released batches, so waiters notice when theirs is dropped
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::jthread thread;
+};
+
+#endif //BILLIARDSHOW_ASSETPREFETCHER_H
@@ -0,0 +1,168 @@
+/**
+ * @file DerivedCache.cpp
+ * @brief Implementation of the DerivedCache class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "DerivedCache.h"
+#include "Hash.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+DerivedCache &DerivedCache::Instance() {
+    static DerivedCache instance;
+    return instance;
+}
+
+/**
+ * @fn Configure
+ * @brief Creates the cache directory if needed and trims it to the new limit.
+ */
+bool DerivedCache::Configure(const std::string &cacheDirectory, uint64_t cacheSizeLimit) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::error_code ec;
+    fs::create_directories(cacheDirectory, ec);
+    if (!fs::is_directory(cacheDirectory, ec)) {
+        Logger::Warn("Could not create cache directory " + cacheDirectory + ", derived assets are not cached");
+        enabled = false;
+        return false;
+    }
+    directory = cacheDirectory;
+    sizeLimit = cacheSizeLimit;
+    enabled = true;
+    TrimLocked();
+    return true;
+}
+
+/**
+ * @fn Key
+ * @brief Hashes the cache version, kind, format version and input hashes into one key.
+ */
+uint64_t DerivedCache::Key(std::string_view kind, uint32_t formatVersion, std::initializer_list<uint64_t> inputs) {
+    const uint32_t versions[2] = {VERSION, formatVersion};
+    uint64_t key = Hash::XXH64(versions, sizeof(versions));
+    key = Hash::XXH64(kind.data(), kind.size(), key);
+    for (uint64_t input: inputs) key = Hash::XXH64(&input, sizeof(input), key);
+    return key;
+}
+
+std::string DerivedCache::PathFor(uint64_t key, std::string_view kind) const {
+    return (fs::path(directory) / (Hash::ToHex(key) + "." + std::string(kind))).generic_string();
+}
+
+/**
+ * @fn Open
+ * @brief Maps an entry and sets its modification time to now, which is its last use for trimming.
+ */
+bool DerivedCache::Open(uint64_t key, std::string_view kind, MappedFile &outFile) {
+    if (!enabled) return false;
+    const std::string path = PathFor(key, kind);
+    if (!outFile.Open(path)) return false;
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    return true;
+}
+
+/**
+ * @fn Store
+ * @brief Writes an entry to a temporary file, renames it into place and trims the cache.
+ * The write happens outside the lock so concurrent loaders do not wait for each other's disk writes.
+ * Entries larger than the whole cache are not stored.
+ */
+bool DerivedCache::Store(uint64_t key, std::string_view kind, std::initializer_list<std::span<const std::byte>> parts) {
+    if (!enabled) return false;
+    uint64_t size = 0;
+    for (const auto &part: parts) size += part.size();
+    const std::string path = PathFor(key, kind);
+    if (size > sizeLimit) {
+        Logger::Warn("Not caching " + path + ": larger than the cache size limit");
+        return false;
+    }
+    const std::string tmpPath = path + "." + std::to_string(tmpCounter.fetch_add(1)) + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            Logger::Warn("Could not write cache entry: " + path);
+            return false;
+        }
+        for (const auto &part: parts)
+            out.write(reinterpret_cast<const char *>(part.data()), (std::streamsize) part.size());
+        if (!out) {
+            Logger::Warn("Failed while writing cache entry: " + path);
+            out.close();
+            std::error_code ec;
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        Logger::Warn("Could not move cache entry into place: " + path + " (" + ec.message() + ")");
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    TrimLocked();
+    return true;
+}
+
+/**
+ * @fn Clear
+ * @brief Deletes every entry; entries that are still mapped stay readable until unmapped.
+ */
+void DerivedCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled) return;
+    std::error_code ec;
+    size_t removed = 0;
+    for (fs::directory_iterator it(directory, ec), end; it != end; it.increment(ec))
+        if (it->is_regular_file() && fs::remove(it->path(), ec)) ++removed;
+    Logger::Info("Cleared " + std::to_string(removed) + " entries from cache " + directory);
+}
+
+void DerivedCache::Trim() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (enabled) TrimLocked();
+}
+
+/**
+ * @fn TrimLocked
+ * @brief Deletes the entries with the oldest modification times until the total fits the limit.
+ * Temporary files of stores in progress are neither counted nor deleted.
+ */
+void DerivedCache::TrimLocked() {
+    struct Entry {
+        fs::file_time_type lastUse;
+        uint64_t size;
+        fs::path path;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() == ".tmp") continue;
+        Entry entry{it->last_write_time(ec), it->file_size(ec), it->path()};
+        if (ec) continue;
+        total += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (total <= sizeLimit) return;
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+    size_t removed = 0;
+    for (const auto &entry: entries) {
+        if (total <= sizeLimit) break;
+        if (fs::remove(entry.path, ec)) {
+            total -= entry.size;
+            ++removed;
+        }
+    }
+    Logger::Info("Evicted " + std::to_string(removed) + " least recently used entries from cache " + directory);
+}
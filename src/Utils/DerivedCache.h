@@ -0,0 +1,108 @@
+/**
+ * @file DerivedCache.h
+ * @brief Header file for the DerivedCache class.
+ * One on-disk directory holds every product derived from the raw assets: compiled meshes,
+ * decoded or compressed texture chains and linked shader program binaries. Each entry is one
+ * file named by a hash of everything its content depends on, so a changed input or a new
+ * format simply looks up a different entry and stale entries age out.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_DERIVEDCACHE_H
+#define BILLIARDSHOW_DERIVEDCACHE_H
+
+#pragma once
+
+#include "MappedFile.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @class DerivedCache
+ * @brief Content-addressed cache of derived assets with a least-recently-used size cap.
+ * Keys combine the cache version, the kind of product, the version of its format and hashes of
+ * its inputs (XXH64 of the source files, plus any setting that changes the output).
+ * Hits are memory mapped. A hit marks its file as used by setting the modification time, and
+ * when the directory grows past its size limit the least recently used files are deleted.
+ * Entries are written to a temporary file and renamed into place, so readers never see a partial
+ * entry. Safe to use from several threads at once.
+ */
+class DerivedCache {
+public:
+    // Bump when a derivation changes its output without a format version change, to orphan all entries
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Gets the process-wide cache.
+     */
+    static DerivedCache &Instance();
+
+    /**
+     * @brief Sets the cache directory and size limit, creating the directory and trimming it to the limit.
+     * Until this is called, the cache is disabled: lookups miss and stores are dropped.
+     * @param directory The cache directory.
+     * @param sizeLimit Maximum total size of the entries in bytes.
+     * @return True if the directory is usable.
+     */
+    bool Configure(const std::string &directory, uint64_t sizeLimit);
+
+    bool IsEnabled() const { return enabled; }
+
+    /**
+     * @brief Builds the key of a derived product.
+     * @param kind Kind of product, also the file extension of its entries, e.g. "mesh".
+     * @param formatVersion Version of the product's file format.
+     * @param inputs Hashes of the inputs and settings the product depends on.
+     */
+    static uint64_t Key(std::string_view kind, uint32_t formatVersion, std::initializer_list<uint64_t> inputs);
+
+    /**
+     * @brief Gets the file an entry is stored in, e.g. "cache/0123456789abcdef.mesh".
+     */
+    std::string PathFor(uint64_t key, std::string_view kind) const;
+
+    /**
+     * @brief Maps an entry and marks it as recently used.
+     * @param outFile Receives the mapping.
+     * @return False on a miss or when the cache is disabled.
+     */
+    bool Open(uint64_t key, std::string_view kind, MappedFile &outFile);
+
+    /**
+     * @brief Writes an entry from one or more byte ranges, then trims the cache to its size limit.
+     * @param parts The ranges, written back to back.
+     * @return True if the entry was written.
+     */
+    bool Store(uint64_t key, std::string_view kind, std::initializer_list<std::span<const std::byte>> parts);
+
+    /**
+     * @brief Deletes every entry.
+     */
+    void Clear();
+
+    /**
+     * @brief Deletes least recently used entries until the cache fits its size limit.
+     */
+    void Trim();
+
+private:
+    DerivedCache() = default;
+
+    void TrimLocked();
+
+    std::mutex mutex; // Serializes trimming and clearing against each other and against stores
+    std::string directory;
+    uint64_t sizeLimit = 0;
+    bool enabled = false;
+    std::atomic<uint64_t> tmpCounter{0}; // Makes temporary file names unique between concurrent stores
+};
+
+#endif //BILLIARDSHOW_DERIVEDCACHE_H
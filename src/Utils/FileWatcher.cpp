@@ -0,0 +1,153 @@
+/**
+ * @file FileWatcher.cpp
+ * @brief Implementation of the FileWatcher class.
+ * Uses inotify on Linux; other platforms get a watcher that never starts.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "FileWatcher.h"
+#include "AssetArchive.h"
+#include "Logger.h"
+
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::~FileWatcher() {
+    Stop();
+}
+
+#ifdef __linux__
+
+/**
+ * @fn Start
+ * @brief Creates the inotify instance, watches every directory under the roots and starts the thread.
+ */
+bool FileWatcher::Start(const std::vector<std::string> &roots) {
+    Stop();
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        Logger::Warn("Could not create an inotify instance, file watching is off");
+        return false;
+    }
+    for (const auto &root: roots) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(root, ec)) {
+            Logger::Warn("Not watching missing directory: " + root);
+            continue;
+        }
+        AddWatch(root);
+        for (std::filesystem::recursive_directory_iterator it(root, ec), end; it != end; it.increment(ec)) {
+            if (ec) break;
+            if (it->is_directory()) AddWatch(it->path().generic_string());
+        }
+    }
+    if (directories.empty()) {
+        Stop();
+        return false;
+    }
+    Logger::Info("Watching " + std::to_string(directories.size()) + " directories for changes");
+    thread = std::jthread([this](std::stop_token stop) { Run(stop); });
+    return true;
+}
+
+/**
+ * @fn AddWatch
+ * @brief Watches one directory for files written or moved into it and for new subdirectories.
+ */
+void FileWatcher::AddWatch(const std::string &directory) {
+    const int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (wd < 0) {
+        Logger::Warn("Could not watch directory: " + directory);
+        return;
+    }
+    directories[wd] = directory;
+}
+
+/**
+ * @fn Run
+ * @brief Reads inotify events until stopped.
+ * The poll timeout bounds how long a stop request waits.
+ */
+void FileWatcher::Run(std::stop_token stop) {
+    alignas(inotify_event) char buffer[16384];
+    pollfd descriptor{fd, POLLIN, 0};
+    while (!stop.stop_requested()) {
+        if (poll(&descriptor, 1, 100) <= 0) continue;
+        const ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0) continue;
+        const auto now = std::chrono::steady_clock::now();
+        for (ssize_t offset = 0; offset < length;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += (ssize_t) (sizeof(inotify_event) + event->len);
+            auto it = directories.find(event->wd);
+            if (it == directories.end() || event->len == 0) continue;
+            const std::string path = it->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                // A new directory may already hold files by the time it is watched; those show up on their next save
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) AddWatch(path);
+                continue;
+            }
+            if (!(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))) continue;
+            std::lock_guard<std::mutex> lock(mutex);
+            pending[AssetArchive::NormalizePath(path)] = now;
+        }
+    }
+}
+
+/**
+ * @fn Stop
+ * @brief Joins the watcher thread and closes the inotify instance, which drops all watches.
+ */
+void FileWatcher::Stop() {
+    if (thread.joinable()) {
+        thread.request_stop();
+        thread.join();
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    directories.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+}
+
+#else
+
+bool FileWatcher::Start(const std::vector<std::string> &) {
+    Logger::Warn("File watching needs inotify and is only available on Linux");
+    return false;
+}
+
+void FileWatcher::AddWatch(const std::string &) {}
+
+void FileWatcher::Run(std::stop_token) {}
+
+void FileWatcher::Stop() {}
+
+#endif
+
+/**
+ * @fn TakeChanges
+ * @brief Removes and returns the pending paths whose last event is older than the settle time.
+ */
+std::vector<std::string> FileWatcher::TakeChanges() {
+    std::vector<std::string> changes;
+    const auto settled = std::chrono::steady_clock::now() - SETTLE_TIME;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (it->second <= settled) {
+            changes.push_back(it->first);
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return changes;
+}
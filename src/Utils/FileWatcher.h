@@ -0,0 +1,78 @@
+/**
+ * @file FileWatcher.h
+ * @brief Header file for the FileWatcher class.
+ * Watches directory trees for files that were written or replaced, using inotify on Linux.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_FILEWATCHER_H
+#define BILLIARDSHOW_FILEWATCHER_H
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class FileWatcher
+ * @brief Collects the paths of changed files under a set of directories on a background thread.
+ * A file counts as changed when it is closed after writing or moved into a watched directory,
+ * which covers both editors that save in place and those that write a temporary file and rename it.
+ * Bursts of events for one file are merged: a path is only reported once it has been quiet for
+ * the settle time, so a save is seen once and never half written.
+ * Directories created later inside a watched tree are watched as well.
+ * On platforms without inotify, Start() fails and nothing is reported.
+ */
+class FileWatcher {
+public:
+    // Time a file must go without events before it is reported
+    static constexpr std::chrono::milliseconds SETTLE_TIME{150};
+
+    FileWatcher() = default;
+
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    /**
+     * @brief Starts watching directory trees.
+     * @param roots Directories to watch recursively; missing ones are skipped with a warning.
+     * @return True if at least one directory is being watched.
+     */
+    bool Start(const std::vector<std::string> &roots);
+
+    /**
+     * @brief Stops the watcher thread and closes the watches.
+     */
+    void Stop();
+
+    bool IsRunning() const { return thread.joinable(); }
+
+    /**
+     * @brief Takes the files that changed and have settled since the last call.
+     * Paths are normalized like AssetArchive::NormalizePath, e.g. "assets/objects/Ball1.obj".
+     * Safe to call from any thread.
+     */
+    std::vector<std::string> TakeChanges();
+
+private:
+    void Run(std::stop_token stop);
+
+    void AddWatch(const std::string &directory);
+
+    int fd = -1; // inotify instance
+    std::unordered_map<int, std::string> directories; // Watch descriptor -> directory path, watcher thread only
+    std::mutex mutex;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> pending; // Path -> last event
+    std::jthread thread;
+};
+
+#endif //BILLIARDSHOW_FILEWATCHER_H
@@ -0,0 +1,62 @@
+/**
+ * @file FixedTimestep.h
+ * @brief Fixed-rate simulation clock driven by variable frame times.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_FIXEDTIMESTEP_H
+#define BILLIARDSHOW_FIXEDTIMESTEP_H
+
+#pragma once
+
+/**
+ * @class FixedTimestep
+ * @brief Turns frame times into a whole number of equal simulation steps.
+ * Frame time accumulates, and each frame runs as many steps as fit in it; the remainder carries
+ * over, and its fraction of a step tells the renderer how far to interpolate between the last two
+ * simulation states. So the simulation gives the same results at any frame rate.
+ * A frame may run at most maxSteps steps. Any time beyond that is dropped, so a long hitch slows
+ * the simulation for one frame instead of making every later frame run more steps to catch up.
+ */
+class FixedTimestep {
+public:
+    /**
+     * @param rate Steps per second.
+     * @param maxSteps Most steps one frame may run.
+     */
+    FixedTimestep(double rate, int maxSteps) : step(1.0 / rate), maxSteps(maxSteps) {}
+
+    /**
+     * @brief Adds the time of a frame and takes the steps that are due.
+     * @param frameTime Seconds since the last frame.
+     * @return Number of steps to run this frame.
+     */
+    int Advance(double frameTime) {
+        if (frameTime > 0.0) accumulator += frameTime;
+        if (accumulator > maxSteps * step) accumulator = maxSteps * step;
+        int steps = 0;
+        while (accumulator >= step) {
+            accumulator -= step;
+            ++steps;
+        }
+        return steps;
+    }
+
+    /**
+     * @brief Gets the length of one step in seconds.
+     */
+    float GetStep() const { return (float) step; }
+
+    /**
+     * @brief Gets how far the frame is between the last two steps, in [0, 1).
+     */
+    float GetAlpha() const { return (float) (accumulator / step); }
+
+private:
+    double step;
+    int maxSteps;
+    double accumulator = 0.0;
+};
+
+#endif //BILLIARDSHOW_FIXEDTIMESTEP_H
@@ -0,0 +1,112 @@
+/**
+ * @file Hash.cpp
+ * @brief Implementation of the XXH64 hash function.
+ * Follows the reference algorithm from the xxHash specification.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "Hash.h"
+
+#include <cstring>
+
+static constexpr uint64_t PRIME1 = 11400714785074694791ull;
+static constexpr uint64_t PRIME2 = 14029467366897019727ull;
+static constexpr uint64_t PRIME3 = 1609587929392839161ull;
+static constexpr uint64_t PRIME4 = 9650029242287828579ull;
+static constexpr uint64_t PRIME5 = 2870177450012600261ull;
+
+static inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t read32(const unsigned char *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME2;
+    acc = rotl(acc, 31);
+    return acc * PRIME1;
+}
+
+static inline uint64_t mergeRound(uint64_t acc, uint64_t val) {
+    acc ^= round(0, val);
+    return acc * PRIME1 + PRIME4;
+}
+
+/**
+ * @fn XXH64
+ * @brief Computes the XXH64 hash of a byte range.
+ * Assumes a little-endian host, which covers every platform the show runs on.
+ */
+uint64_t Hash::XXH64(const void *data, size_t size, uint64_t seed) {
+    const auto *p = static_cast<const unsigned char *>(data);
+    const unsigned char *end = p + size;
+    uint64_t h;
+    if (size >= 32) {
+        const unsigned char *limit = end - 32;
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        do {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    } else {
+        h = seed + PRIME5;
+    }
+    h += static_cast<uint64_t>(size);
+    while (p + 8 <= end) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * PRIME1 + PRIME4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(read32(p)) * PRIME1;
+        h = rotl(h, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (*p) * PRIME5;
+        h = rotl(h, 11) * PRIME1;
+        ++p;
+    }
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * @fn ToHex
+ * @brief Formats a hash as a fixed-width, lowercase hexadecimal string.
+ */
+std::string Hash::ToHex(uint64_t hash) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        out[i] = digits[hash & 0xF];
+        hash >>= 4;
+    }
+    return out;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file Hash.h
+ * @brief Fast non-cryptographic hashing used to key loaded and derived assets.
+ * Implements the 64-bit xxHash algorithm (XXH64).
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_HASH_H
+#define BILLIARDSHOW_HASH_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Hash {
+    /**
+     * @brief Computes the XXH64 hash of a byte range.
+     * @param data Pointer to the bytes to hash.
+     * @param size Number of bytes.
+     * @param seed Seed value; chaining hashes by passing the previous result as the seed
+     * combines several ranges into one key.
+     * @return The 64-bit hash.
+     */
+    uint64_t XXH64(const void *data, size_t size, uint64_t seed = 0);
+
+    /**
+     * @brief Formats a hash as a fixed-width, lowercase hexadecimal string.
+     * @param hash The hash value.
+     * @return A 16 character string.
+     */
+    std::string ToHex(uint64_t hash);
+}
+
+#endif //BILLIARDSHOW_HASH_H
@@ -0,0 +1,76 @@
+/**
+ * @file HotReloader.cpp
+ * @brief Implementation of the HotReloader class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "HotReloader.h"
+#include "AssetArchive.h"
+#include "Logger.h"
+
+// One worker keeps the reloads of a file in the order of its changes
+HotReloader::HotReloader() : worker(std::make_unique<ThreadPool>(1)) {}
+
+HotReloader::~HotReloader() {
+    // Let running prepares finish before the handlers they use are destroyed
+    watcher.Stop();
+    worker.reset();
+}
+
+/**
+ * @fn Start
+ * @brief Starts the file watcher on the given directories.
+ */
+bool HotReloader::Start(const std::vector<std::string> &roots) {
+    return watcher.Start(roots);
+}
+
+/**
+ * @fn Register
+ * @brief Adds a reload handler for a file.
+ */
+void HotReloader::Register(const std::string &path, Prepare prepare) {
+    handlers[AssetArchive::NormalizePath(path)].push_back(std::move(prepare));
+}
+
+/**
+ * @fn Update
+ * @brief Applies finished reloads, then launches reloads for newly changed files.
+ * A file that changes again while its reload is being prepared is reloaded once more afterwards,
+ * so the last save always wins without piling up work.
+ */
+void HotReloader::Update() {
+    std::vector<std::pair<std::string, std::vector<Apply>>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.swap(finished);
+    }
+    for (auto &[path, applies]: ready) {
+        for (auto &apply: applies)
+            if (apply) apply();
+        inFlight.erase(path);
+        if (changedAgain.erase(path)) Launch(path);
+    }
+    if (!watcher.IsRunning()) return;
+    for (const auto &path: watcher.TakeChanges()) {
+        if (handlers.find(path) == handlers.end()) continue;
+        if (inFlight.count(path)) changedAgain.insert(path);
+        else Launch(path);
+    }
+}
+
+/**
+ * @fn Launch
+ * @brief Runs the prepare functions of a file on the worker thread.
+ */
+void HotReloader::Launch(const std::string &path) {
+    Logger::Info("Reloading " + path);
+    inFlight.insert(path);
+    worker->Submit([this, path, prepares = handlers[path]]() {
+        std::vector<Apply> applies;
+        for (const auto &prepare: prepares) applies.push_back(prepare(path));
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.emplace_back(path, std::move(applies));
+    });
+}
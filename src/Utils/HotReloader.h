@@ -0,0 +1,85 @@
+/**
+ * @file HotReloader.h
+ * @brief Header file for the HotReloader class.
+ * Reloads individual resources while the app runs when their files change on disk.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_HOTRELOADER_H
+#define BILLIARDSHOW_HOTRELOADER_H
+
+#pragma once
+
+#include "FileWatcher.h"
+#include "ThreadPool.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class HotReloader
+ * @brief Maps changed files to reload handlers and runs them in two halves.
+ * Owners of a resource register its file with a prepare function. When the FileWatcher reports
+ * the file, the prepare function runs on a worker thread (reading, parsing, decoding) and returns
+ * an apply function, which Update() runs on the GL thread at the top of a later frame to swap the
+ * new resource in. A frame therefore sees either the old resource or the complete new one.
+ * Only the resources registered for a changed file are reloaded.
+ * All methods must be called on the thread that owns the OpenGL context.
+ */
+class HotReloader {
+public:
+    // Runs on the GL thread; swaps the prepared resource in
+    using Apply = std::function<void()>;
+    // Runs on the worker with the changed path; must make no OpenGL calls and should return an apply
+    // function even on failure if it holds resources that must be released on the GL thread
+    using Prepare = std::function<Apply(const std::string &path)>;
+
+    HotReloader();
+
+    ~HotReloader();
+
+    HotReloader(const HotReloader &) = delete;
+
+    HotReloader &operator=(const HotReloader &) = delete;
+
+    /**
+     * @brief Starts watching directory trees for changes.
+     * @param roots Directories to watch recursively.
+     * @return True if file watching is running.
+     */
+    bool Start(const std::vector<std::string> &roots);
+
+    /**
+     * @brief Registers a reload handler for a file; a file may have several handlers.
+     * @param path Path of the file as the loaders open it, e.g. "shaders/basic.frag".
+     * @param prepare Handler that prepares the reload off the GL thread.
+     */
+    void Register(const std::string &path, Prepare prepare);
+
+    /**
+     * @brief Starts reloads for changed files and applies the reloads that have finished.
+     * Call once at the top of every frame.
+     */
+    void Update();
+
+    bool IsRunning() const { return watcher.IsRunning(); }
+
+private:
+    void Launch(const std::string &path);
+
+    FileWatcher watcher;
+    std::unordered_map<std::string, std::vector<Prepare>> handlers; // Normalized path -> handlers
+    std::unordered_set<std::string> inFlight;   // Paths being prepared
+    std::unordered_set<std::string> changedAgain; // Paths that changed while being prepared
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::vector<Apply>>> finished; // Filled by the worker
+    std::unique_ptr<ThreadPool> worker; // Declared last so it is joined before the state it uses goes away
+};
+
+#endif //BILLIARDSHOW_HOTRELOADER_H
@@ -0,0 +1,76 @@
+/**
+ * @file LoadProgress.h
+ * @brief Byte-based progress counter shared by asset loading threads.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_LOADPROGRESS_H
+#define BILLIARDSHOW_LOADPROGRESS_H
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class LoadProgress
+ * @brief Counts the bytes processed across all assets of a load.
+ * The loader adds the size of every asset to the total, then each stage advances the counter as it
+ * consumes its input, so the fraction grows smoothly instead of jumping once per asset. Assets whose
+ * size is only known once their own load starts are announced up front with ExpectTotals(); until
+ * their sizes arrive they count as the average of the sizes added so far. All methods are thread-safe.
+ */
+class LoadProgress {
+public:
+    /**
+     * @brief Adds bytes that the load is expected to process.
+     */
+    void AddTotal(uint64_t bytes) { total.fetch_add(bytes, std::memory_order_relaxed); }
+
+    /**
+     * @brief Announces assets whose sizes will be added later with AddExpectedTotal().
+     */
+    void ExpectTotals(uint64_t assets) { expected.fetch_add(assets, std::memory_order_relaxed); }
+
+    /**
+     * @brief Adds the bytes of one announced asset.
+     */
+    void AddExpectedTotal(uint64_t bytes) {
+        total.fetch_add(bytes, std::memory_order_relaxed);
+        measured.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records bytes that have been processed.
+     */
+    void Advance(uint64_t bytes) { done.fetch_add(bytes, std::memory_order_relaxed); }
+
+    uint64_t GetTotal() const { return total.load(std::memory_order_relaxed); }
+
+    uint64_t GetDone() const { return done.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the processed fraction of the expected bytes, clamped to [0, 1].
+     */
+    float GetFraction() const {
+        const uint64_t m = measured.load(std::memory_order_relaxed);
+        const uint64_t e = expected.load(std::memory_order_relaxed);
+        double t = (double) GetTotal();
+        if (m < e) {
+            if (m == 0) return 0.0f; // Nothing to estimate the missing sizes from yet
+            t += t / (double) m * (double) (e - m);
+        }
+        if (t == 0) return 0.0f;
+        const double f = (double) GetDone() / t;
+        return f < 1.0 ? (float) f : 1.0f;
+    }
+
+private:
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> done{0};
+    std::atomic<uint64_t> expected{0}; // Assets announced by ExpectTotals()
+    std::atomic<uint64_t> measured{0}; // Of those, the ones whose bytes were added
+};
+
+#endif //BILLIARDSHOW_LOADPROGRESS_H
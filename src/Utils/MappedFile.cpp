@@ -0,0 +1,130 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the MappedFile class.
+ * Uses CreateFileMapping/MapViewOfFile on Windows and mmap on POSIX systems.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        open = std::exchange(other.open, false);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+/**
+ * @fn Open
+ * @brief Maps the given file read-only.
+ * Empty files are reported as open with a null data pointer and zero size,
+ * since neither platform allows a zero-length mapping.
+ * @param path The path to the file.
+ * @return True if the file could be opened and mapped, false otherwise.
+ */
+bool MappedFile::Open(const std::string &path) {
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    open = true;
+    if (fileSize.QuadPart == 0) return true;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        Close();
+        return false;
+    }
+    mappingHandle = mapping;
+    data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        Close();
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    open = true;
+    if (st.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file
+    if (mapped == MAP_FAILED) {
+        open = false;
+        return false;
+    }
+    madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    data = static_cast<const char *>(mapped);
+    size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+/**
+ * @fn Close
+ * @brief Unmaps the file and closes its handle.
+ * Safe to call on a closed or never opened MappedFile.
+ */
+void MappedFile::Close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (data) munmap(const_cast<char *>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    open = false;
+}
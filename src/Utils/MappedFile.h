@@ -0,0 +1,78 @@
+/**
+ * @file MappedFile.h
+ * @brief Header file for the MappedFile class.
+ * This class maps a file read-only into the address space of the process,
+ * so loaders can tokenize its contents in place without copying them into strings.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_MAPPEDFILE_H
+#define BILLIARDSHOW_MAPPEDFILE_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief RAII wrapper around a read-only memory mapping of a whole file.
+ * The mapping is released when the object is destroyed or Close() is called.
+ */
+class MappedFile {
+public:
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Maps the given file read-only.
+     * Any previously mapped file is closed first.
+     * @param path The path to the file.
+     * @return True if the file could be opened and mapped, false otherwise.
+     */
+    bool Open(const std::string &path);
+
+    /**
+     * @brief Unmaps the file and closes its handle.
+     */
+    void Close();
+
+    /**
+     * @brief Gets the first byte of the mapping.
+     * @return Pointer to the mapped bytes, or nullptr for an empty or closed file.
+     */
+    const char *Data() const { return data; }
+
+    /**
+     * @brief Gets the size of the mapping.
+     * @return The size of the mapped file in bytes.
+     */
+    size_t Size() const { return size; }
+
+    /**
+     * @brief Checks whether a file is currently open.
+     * @return True if Open() succeeded and Close() has not been called since.
+     */
+    bool IsOpen() const { return open; }
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool open = false;
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+};
+
+#endif //BILLIARDSHOW_MAPPEDFILE_H
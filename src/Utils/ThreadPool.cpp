@@ -0,0 +1,99 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the ThreadPool class.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "ThreadPool.h"
+#include "Logger.h"
+
+/**
+ * @fn ResolveThreadCount
+ * @brief Resolves a requested worker count, mapping 0 to the number of hardware threads.
+ * hardware_concurrency may report 0 when it cannot tell, so at least one worker is always used.
+ */
+unsigned int ThreadPool::ResolveThreadCount(unsigned int requested) {
+    if (requested > 0) return requested;
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// Set for the lifetime of every worker thread
+static thread_local bool isWorker = false;
+
+/**
+ * @fn IsWorkerThread
+ * @brief Checks whether the calling thread is a worker of some ThreadPool.
+ */
+bool ThreadPool::IsWorkerThread() {
+    return isWorker;
+}
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    unsigned int count = ResolveThreadCount(threadCount);
+    workers.reserve(count);
+    for (unsigned int i = 0; i < count; ++i)
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (auto &worker: workers)
+        worker.join();
+}
+
+/**
+ * @fn Submit
+ * @brief Queues a job for execution on a worker thread.
+ */
+void ThreadPool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+/**
+ * @fn Wait
+ * @brief Blocks until the queue is empty and no job is running.
+ */
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this]() { return jobs.empty() && activeJobs == 0; });
+}
+
+/**
+ * @fn WorkerLoop
+ * @brief Pops and runs jobs until the pool is stopped and the queue is drained.
+ * Exceptions escaping a job are logged so one bad asset cannot take down the loader.
+ */
+void ThreadPool::WorkerLoop() {
+    isWorker = true;
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // Stopping and nothing left to do
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            ++activeJobs;
+        }
+        try {
+            job();
+        } catch (const std::exception &e) {
+            Logger::Error(std::string("Unhandled exception in worker thread: ") + e.what());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --activeJobs;
+            if (jobs.empty() && activeJobs == 0) allDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ThreadPool.h
+ * @brief Header file for the ThreadPool class.
+ * A fixed-size pool of worker threads that runs submitted jobs in FIFO order.
+ * Used to spread asset loading (file reads, parsing, image decoding) across cores.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#ifndef BILLIARDSHOW_THREADPOOL_H
+#define BILLIARDSHOW_THREADPOOL_H
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Runs jobs on a fixed set of worker threads.
+ * Jobs must not make OpenGL calls; the GL context belongs to the main thread.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount Number of workers; 0 uses one per hardware thread.
+     */
+    explicit ThreadPool(unsigned int threadCount = 0);
+
+    /**
+     * @brief Finishes all queued jobs and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Queues a job for execution on a worker thread.
+     * @param job The job to run.
+     */
+    void Submit(std::function<void()> job);
+
+    /**
+     * @brief Blocks until every submitted job has finished.
+     */
+    void Wait();
+
+    /**
+     * @brief Gets the number of worker threads.
+     */
+    unsigned int GetThreadCount() const { return (unsigned int) workers.size(); }
+
+    /**
+     * @brief Resolves a requested worker count, mapping 0 to the number of hardware threads.
+     */
+    static unsigned int ResolveThreadCount(unsigned int requested);
+
+    /**
+     * @brief Checks whether the calling thread is a worker of some ThreadPool.
+     * Lets nested parallel work run on the calling thread instead of oversubscribing the cores.
+     */
+    static bool IsWorkerThread();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable allDone;
+    size_t activeJobs = 0;
+    bool stopping = false;
+};
+
+#endif //BILLIARDSHOW_THREADPOOL_H
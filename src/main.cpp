@@ -25,6 +25,9 @@
  */
 #include "App.h"
 
+#include <cstdlib>
+#include <cstring>
+
 /**
  * @fn main
  * @brief Main entry point for the BilliardShow application.
@@ -32,12 +35,24 @@
  * and calls its Run method to start the application.
  * Logs the start and exit of the application.
  * @param argc Argument count.
- * @param argv Argument vector (not used).
+ * @param argv Argument vector; --clear-cache deletes the derived-asset cache before loading, and
+ * --ball-segments <n> draws the balls as generated spheres with n segments (at least 3) instead of the OBJ
+ * geometry.
  * @return Exit status of the application (0 for success).
  */
 int main(int argc, char **argv) {
     Logger::Info("BilliardShow started.");
     App app;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--clear-cache") == 0) DerivedCache::Instance().Clear();
+        else if (std::strcmp(argv[i], "--ball-segments") == 0 && i + 1 < argc) {
+            // A sphere needs at least 3 segments; anything less keeps the OBJ geometry
+            const int segments = std::atoi(argv[++i]);
+            if (segments > 0 && segments < 3)
+                Logger::Warn(std::string("Ignoring --ball-segments ") + argv[i] + ": a sphere needs at least 3");
+            else app.SetBallTessellation(segments);
+        } else Logger::Warn(std::string("Ignoring unknown argument: ") + argv[i]);
+    }
     app.Run();
     Logger::Info("BilliardShow exited.");
     return 0;
@@ -0,0 +1,163 @@
+/**
+ * @file AssetPacker.cpp
+ * @brief Command line tool that packs asset files into one archive for AssetArchive.
+ * Usage: AssetPacker <output.pak> <file or directory>...
+ * Directories are packed recursively. Paths are stored as given, relative to the working
+ * directory the app will run in, so run the packer from the project root:
+ *     AssetPacker assets.pak assets shaders
+ * Temporary files are skipped. The derived-asset cache is not packed: its entries are keyed by
+ * the contents of the sources, so they are rebuilt on the first run from the packed files.
+ * @author Ahmet Abdullah Gultekin
+ * @date 2026-10-16
+ * @version 1.0
+ */
+#include "../src/Utils/AssetArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct PackedFile {
+    std::string name;   // Archive key
+    fs::path path;      // File on disk
+    uint64_t size;
+};
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + AssetArchive::ALIGNMENT - 1) & ~uint64_t(AssetArchive::ALIGNMENT - 1);
+}
+
+static bool addFile(const fs::path &path, std::vector<PackedFile> &files) {
+    if (path.extension() == ".tmp") return true;
+    std::error_code ec;
+    auto size = fs::file_size(path, ec);
+    if (ec) {
+        std::cerr << "Cannot read " << path.string() << ": " << ec.message() << std::endl;
+        return false;
+    }
+    files.push_back({AssetArchive::NormalizePath(path.generic_string()), path, static_cast<uint64_t>(size)});
+    return true;
+}
+
+static bool collect(const fs::path &input, std::vector<PackedFile> &files) {
+    std::error_code ec;
+    if (fs::is_regular_file(input, ec)) return addFile(input, files);
+    if (!fs::is_directory(input, ec)) {
+        std::cerr << "No such file or directory: " << input.string() << std::endl;
+        return false;
+    }
+    for (fs::recursive_directory_iterator it(input, ec), end; it != end; it.increment(ec)) {
+        if (ec) {
+            std::cerr << "Cannot list " << input.string() << ": " << ec.message() << std::endl;
+            return false;
+        }
+        if (it->is_regular_file() && !addFile(it->path(), files)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the archive: header, table of contents, names, then each file on an aligned offset.
+ * The archive is written to a temporary file and renamed into place, so a deployment either sees
+ * the old archive or the complete new one.
+ */
+static bool writeArchive(const fs::path &output, const std::vector<PackedFile> &files) {
+    std::vector<AssetArchive::Entry> toc(files.size());
+    std::string names;
+    for (size_t i = 0; i < files.size(); ++i) {
+        toc[i].nameOffset = static_cast<uint32_t>(names.size());
+        toc[i].nameLength = static_cast<uint32_t>(files[i].name.size());
+        toc[i].size = files[i].size;
+        names += files[i].name;
+    }
+    AssetArchive::Header header = {};
+    header.magic = AssetArchive::MAGIC;
+    header.version = AssetArchive::VERSION;
+    header.entryCount = static_cast<uint32_t>(files.size());
+    header.entrySize = sizeof(AssetArchive::Entry);
+    header.tocOffset = alignUp(sizeof(header));
+    header.namesOffset = header.tocOffset + toc.size() * sizeof(AssetArchive::Entry);
+    header.namesSize = names.size();
+    uint64_t offset = header.namesOffset + header.namesSize;
+    for (auto &entry: toc) {
+        entry.dataOffset = alignUp(offset);
+        offset = entry.dataOffset + entry.size;
+    }
+    header.archiveSize = offset;
+
+    const fs::path tmpPath = output.string() + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot create " << tmpPath.string() << std::endl;
+            return false;
+        }
+        const char zeros[AssetArchive::ALIGNMENT] = {};
+        auto padTo = [&](uint64_t target) {
+            uint64_t position = static_cast<uint64_t>(out.tellp());
+            out.write(zeros, static_cast<std::streamsize>(target - position));
+        };
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        padTo(header.tocOffset);
+        out.write(reinterpret_cast<const char *>(toc.data()),
+                  static_cast<std::streamsize>(toc.size() * sizeof(AssetArchive::Entry)));
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+        std::vector<char> buffer;
+        for (size_t i = 0; i < files.size(); ++i) {
+            padTo(toc[i].dataOffset);
+            std::ifstream in(files[i].path, std::ios::binary);
+            buffer.resize(files[i].size);
+            if (!in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                std::cerr << "Cannot read " << files[i].path.string() << std::endl;
+                return false;
+            }
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        if (!out) {
+            std::cerr << "Failed while writing " << tmpPath.string() << std::endl;
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmpPath, output, ec);
+    if (ec) {
+        std::cerr << "Cannot move archive into place: " << ec.message() << std::endl;
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.pak> <file or directory>..." << std::endl;
+        return 2;
+    }
+    std::vector<PackedFile> files;
+    for (int i = 2; i < argc; ++i)
+        if (!collect(argv[i], files)) return 1;
+    std::sort(files.begin(), files.end(), [](const PackedFile &a, const PackedFile &b) { return a.name < b.name; });
+    auto duplicate = std::adjacent_find(files.begin(), files.end(),
+                                        [](const PackedFile &a, const PackedFile &b) { return a.name == b.name; });
+    if (duplicate != files.end()) {
+        std::cerr << "File given twice: " << duplicate->name << std::endl;
+        return 1;
+    }
+    if (!writeArchive(argv[1], files)) return 1;
+
+    // Read the archive back through the runtime reader, so a broken archive never gets deployed
+    if (!AssetArchive::Instance().Mount(argv[1]) || AssetArchive::Instance().GetEntryCount() != files.size()) {
+        std::cerr << "Archive failed validation: " << argv[1] << std::endl;
+        return 1;
+    }
+    uint64_t bytes = 0;
+    for (const auto &file: files) bytes += file.size;
+    std::cout << "Packed " << files.size() << " files (" << bytes << " bytes) into " << argv[1] << std::endl;
+    return 0;
+}